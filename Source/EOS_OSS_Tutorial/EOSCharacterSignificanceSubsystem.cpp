@@ -0,0 +1,159 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EOSCharacterSignificanceSubsystem.h"
+
+#include "EOS_OSS_TutorialCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+bool UEOSCharacterSignificanceSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Clients keep full rate, they need smooth animation for whatever they can see
+	return IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+TStatId UEOSCharacterSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEOSCharacterSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UEOSCharacterSignificanceSubsystem::RegisterCharacter(AEOS_OSS_TutorialCharacter* Character)
+{
+	if (!Character || TrackedCharacters.ContainsByPredicate([Character](const FTrackedCharacter& Tracked) { return Tracked.Character == Character; }))
+	{
+		return;
+	}
+
+	FTrackedCharacter& Tracked = TrackedCharacters.AddDefaulted_GetRef();
+	Tracked.Character = Character;
+	Tracked.DefaultMovementTickInterval = Character->GetCharacterMovement()->GetComponentTickInterval();
+	Tracked.DefaultMeshTickInterval = Character->GetMesh()->GetComponentTickInterval();
+	Tracked.DefaultAnimTickOption = Character->GetMesh()->VisibilityBasedAnimTickOption;
+}
+
+void UEOSCharacterSignificanceSubsystem::UnregisterCharacter(AEOS_OSS_TutorialCharacter* Character)
+{
+	TrackedCharacters.RemoveAllSwap([Character](const FTrackedCharacter& Tracked) { return Tracked.Character == Character; });
+}
+
+void UEOSCharacterSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceLastUpdate += DeltaTime;
+	if (TimeSinceLastUpdate < UpdateInterval || TrackedCharacters.Num() == 0)
+	{
+		return;
+	}
+
+	TimeSinceLastUpdate = 0.f;
+	UpdateSignificance();
+}
+
+void UEOSCharacterSignificanceSubsystem::UpdateSignificance()
+{
+	const int32 NumCharacters = TrackedCharacters.Num();
+
+	// Gather the locations first, the distance check below compares every pair
+	Locations.SetNumUninitialized(NumCharacters);
+	IsPlayerControlled.SetNumUninitialized(NumCharacters);
+	for (int32 Index = 0; Index < NumCharacters; ++Index)
+	{
+		const AEOS_OSS_TutorialCharacter* Character = TrackedCharacters[Index].Character.Get();
+		Locations[Index] = Character ? Character->GetActorLocation() : FVector::ZeroVector;
+		IsPlayerControlled[Index] = Character && Character->IsPlayerControlled() ? 1 : 0;
+	}
+
+	int32 NumPerSignificance[3] = { 0, 0, 0 };
+
+	for (int32 Index = 0; Index < NumCharacters; ++Index)
+	{
+		FTrackedCharacter& Tracked = TrackedCharacters[Index];
+		const AEOS_OSS_TutorialCharacter* Character = Tracked.Character.Get();
+
+		// Dormant characters (e.g. in the pawn pool) have their movement deactivated and ticking off already
+		if (!Character || !Character->GetCharacterMovement()->IsActive())
+		{
+			continue;
+		}
+
+		const float Score = ScoreCharacter(Index);
+
+		EEOSCharacterSignificance NewSignificance = EEOSCharacterSignificance::Low;
+		if (Score >= HighSignificanceThreshold)
+		{
+			NewSignificance = EEOSCharacterSignificance::High;
+		}
+		else if (Score >= MediumSignificanceThreshold)
+		{
+			NewSignificance = EEOSCharacterSignificance::Medium;
+		}
+
+		if (NewSignificance != Tracked.Significance)
+		{
+			ApplySignificance(Tracked, NewSignificance);
+		}
+
+		NumPerSignificance[static_cast<int32>(NewSignificance)]++;
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("Character significance: %d high, %d medium, %d low."), NumPerSignificance[0], NumPerSignificance[1], NumPerSignificance[2]);
+}
+
+float UEOSCharacterSignificanceSubsystem::ScoreCharacter(int32 Index) const
+{
+	const AEOS_OSS_TutorialCharacter* Character = TrackedCharacters[Index].Character.Get();
+	const UCharacterMovementComponent* Movement = Character->GetCharacterMovement();
+
+	// Distance to the nearest other player
+	double NearestDistanceSquared = TNumericLimits<double>::Max();
+	for (int32 OtherIndex = 0; OtherIndex < Locations.Num(); ++OtherIndex)
+	{
+		if (OtherIndex != Index && IsPlayerControlled[OtherIndex])
+		{
+			NearestDistanceSquared = FMath::Min(NearestDistanceSquared, FVector::DistSquared(Locations[Index], Locations[OtherIndex]));
+		}
+	}
+
+	// Clamp before narrowing, with no other player around the distance is still DBL_MAX which doesn't fit in a float
+	const float NearestDistance = static_cast<float>(FMath::Min(FMath::Sqrt(NearestDistanceSquared), static_cast<double>(FarDistance)));
+	const float DistanceScore = FMath::GetMappedRangeValueClamped(FVector2f(NearDistance, FarDistance), FVector2f(1.f, 0.f), NearestDistance);
+
+	// Moving characters matter more than idle ones
+	const float MaxSpeed = Movement->GetMaxSpeed();
+	const float MovementScore = MaxSpeed > 0.f ? FMath::Clamp(static_cast<float>(Movement->Velocity.Size()) / MaxSpeed, 0.f, 1.f) : 0.f;
+
+	const float Relevance = IsPlayerControlled[Index] ? 1.f : UncontrolledRelevance;
+
+	return Relevance * (DistanceWeight * DistanceScore + (1.f - DistanceWeight) * MovementScore);
+}
+
+void UEOSCharacterSignificanceSubsystem::ApplySignificance(FTrackedCharacter& Tracked, EEOSCharacterSignificance NewSignificance) const
+{
+	AEOS_OSS_TutorialCharacter* Character = Tracked.Character.Get();
+	UCharacterMovementComponent* Movement = Character->GetCharacterMovement();
+	USkeletalMeshComponent* Mesh = Character->GetMesh();
+
+	switch (NewSignificance)
+	{
+	case EEOSCharacterSignificance::High:
+		Movement->SetComponentTickInterval(Tracked.DefaultMovementTickInterval);
+		Mesh->SetComponentTickInterval(Tracked.DefaultMeshTickInterval);
+		Mesh->VisibilityBasedAnimTickOption = Tracked.DefaultAnimTickOption;
+		break;
+	case EEOSCharacterSignificance::Medium:
+		Movement->SetComponentTickInterval(FMath::Max(Tracked.DefaultMovementTickInterval, MediumMovementTickInterval));
+		Mesh->SetComponentTickInterval(FMath::Max(Tracked.DefaultMeshTickInterval, MediumMeshTickInterval));
+		Mesh->VisibilityBasedAnimTickOption = Tracked.DefaultAnimTickOption;
+		break;
+	case EEOSCharacterSignificance::Low:
+		// Nobody is around to see the pose, only keep montages (which can drive gameplay events) evaluating
+		Movement->SetComponentTickInterval(FMath::Max(Tracked.DefaultMovementTickInterval, LowMovementTickInterval));
+		Mesh->SetComponentTickInterval(FMath::Max(Tracked.DefaultMeshTickInterval, LowMeshTickInterval));
+		Mesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+		break;
+	}
+
+	Tracked.Significance = NewSignificance;
+}
@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "EOSCharacterSignificanceSubsystem.generated.h"
+
+class AEOS_OSS_TutorialCharacter;
+
+enum class EEOSCharacterSignificance : uint8
+{
+	High,
+	Medium,
+	Low
+};
+
+/**
+ * Scores how much each character matters on the dedicated server (distance to the nearest other player, how fast it is moving and
+ * whether a player controls it) and throttles its movement tick, mesh tick and animation evaluation to match. High significance
+ * characters run at their default rates, so server frame time grows with the number of characters that actually matter.
+ */
+UCLASS(config=Game)
+class EOS_OSS_TUTORIAL_API UEOSCharacterSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+
+	// How often significance is re-evaluated, in seconds. 
+	UPROPERTY(config)
+	float UpdateInterval = 0.25f;
+
+	// Characters within NearDistance of another player get the full distance score, beyond FarDistance they get none. 
+	UPROPERTY(config)
+	float NearDistance = 1500.f;
+
+	UPROPERTY(config)
+	float FarDistance = 6000.f;
+
+	// Weight of the distance score, the movement score gets the rest. 
+	UPROPERTY(config)
+	float DistanceWeight = 0.7f;
+
+	// Score multiplier for characters no player controls. 
+	UPROPERTY(config)
+	float UncontrolledRelevance = 0.5f;
+
+	UPROPERTY(config)
+	float HighSignificanceThreshold = 0.6f;
+
+	UPROPERTY(config)
+	float MediumSignificanceThreshold = 0.25f;
+
+	UPROPERTY(config)
+	float MediumMovementTickInterval = 0.033f;
+
+	UPROPERTY(config)
+	float LowMovementTickInterval = 0.1f;
+
+	UPROPERTY(config)
+	float MediumMeshTickInterval = 0.1f;
+
+	UPROPERTY(config)
+	float LowMeshTickInterval = 0.25f;
+
+	struct FTrackedCharacter
+	{
+		TWeakObjectPtr<AEOS_OSS_TutorialCharacter> Character;
+
+		EEOSCharacterSignificance Significance = EEOSCharacterSignificance::High;
+
+		// What the character was set up with, restored when it becomes highly significant again. 
+		float DefaultMovementTickInterval = 0.f;
+		float DefaultMeshTickInterval = 0.f;
+		EVisibilityBasedAnimTickOption DefaultAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPose;
+	};
+
+	TArray<FTrackedCharacter> TrackedCharacters;
+
+	// Scratch buffers reused every update. 
+	TArray<FVector> Locations;
+	TArray<uint8> IsPlayerControlled;
+
+	float TimeSinceLastUpdate = 0.f;
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	void RegisterCharacter(AEOS_OSS_TutorialCharacter* Character);
+
+	void UnregisterCharacter(AEOS_OSS_TutorialCharacter* Character);
+
+private:
+
+	void UpdateSignificance();
+
+	float ScoreCharacter(int32 Index) const;
+
+	void ApplySignificance(FTrackedCharacter& Tracked, EEOSCharacterSignificance NewSignificance) const;
+};
@@ -0,0 +1,17 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EOSEntryGameMode.h"
+
+#include "EOSGameSession.h"
+#include "EOSPlayerController.h"
+
+AEOSEntryGameMode::AEOSEntryGameMode()
+{
+	// Nothing to play in the entry map, so no pawn. Referencing the gameplay pawn here would load it synchronously again.
+	DefaultPawnClass = nullptr;
+	bStartPlayersAsSpectators = true;
+
+	PlayerControllerClass = AEOSPlayerController::StaticClass(); // Logs into EOS in BeginPlay
+	GameSessionClass = AEOSGameSession::StaticClass(); // Keeps the engine from calling AutoLogin as well
+}
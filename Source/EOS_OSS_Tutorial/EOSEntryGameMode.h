@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameModeBase.h"
+#include "EOSEntryGameMode.generated.h"
+
+/**
+ * Game mode of the lightweight entry map game clients boot into. It only spawns the player controller, which logs into EOS,
+ * while the gameplay map and pawn assets are preloaded in the background by UEOSPreloadSubsystem.
+ */
+UCLASS()
+class EOS_OSS_TUTORIAL_API AEOSEntryGameMode : public AGameModeBase
+{
+	GENERATED_BODY()
+
+public:
+
+	AEOSEntryGameMode();
+};
@@ -4,6 +4,9 @@
 #include "EOSGameSession.h"
 
 #include "EOSPlayerController.h"
+#include "EOSReservationBeaconHostObject.h"
+#include "Kismet/GameplayStatics.h"
+#include "OnlineBeaconHost.h"
 #include "OnlineSubsystem.h"
 #include "OnlineSubsystemUtils.h"
 #include "OnlineSubsystemTypes.h"
@@ -12,6 +15,43 @@
 #include "GameFramework/PlayerState.h"
 #include "Interfaces/OnlineIdentityInterface.h"
 #include "Interfaces/OnlineStatsInterface.h"
+#include "TimerManager.h"
+#include "Engine/NetConnection.h"
+
+void AEOSGameSession::InitOptions(const FString& Options)
+{
+	Super::InitOptions(Options);
+
+	// The ?MaxPlayers= URL option (already parsed into MaxPlayers by Super) overrides the config, the command line overrides both
+	if (UGameplayStatics::HasOption(Options, TEXT("MaxPlayers")))
+	{
+		MaxNumberOfPlayersInSession = MaxPlayers;
+	}
+
+	// Command line overrides the config, e.g. -MaxPlayersInSession=4 -MinPlayersToStart=2 -StartCountdown=60 -MinStartCountdown=10 -StartTimeout=300
+	FParse::Value(FCommandLine::Get(), TEXT("MaxPlayersInSession="), MaxNumberOfPlayersInSession);
+	FParse::Value(FCommandLine::Get(), TEXT("MinPlayersToStart="), MinPlayersToStart);
+	FParse::Value(FCommandLine::Get(), TEXT("StartCountdown="), MaxStartCountdown);
+	FParse::Value(FCommandLine::Get(), TEXT("MinStartCountdown="), MinStartCountdown);
+	FParse::Value(FCommandLine::Get(), TEXT("StartTimeout="), StartHardTimeout);
+
+	SetSessionCapacity(MaxNumberOfPlayersInSession);
+}
+
+void AEOSGameSession::SetSessionCapacity(int32 Capacity)
+{
+	MaxNumberOfPlayersInSession = FMath::Max(Capacity, 1);
+	MaxPlayers = MaxNumberOfPlayersInSession; // Keep the engine's own capacity check in line with the session
+	UE_LOG(LogTemp, Log, TEXT("Session capacity is %d players."), MaxNumberOfPlayersInSession);
+
+	FEOSMatchStartSettings MatchStartSettings;
+	MatchStartSettings.Capacity = MaxNumberOfPlayersInSession;
+	MatchStartSettings.MinPlayers = MinPlayersToStart;
+	MatchStartSettings.MaxCountdown = MaxStartCountdown;
+	MatchStartSettings.MinCountdown = MinStartCountdown;
+	MatchStartSettings.HardTimeout = StartHardTimeout;
+	MatchStartScheduler.Configure(MatchStartSettings);
+}
 
 void AEOSGameSession::BeginPlay()
 {
@@ -20,14 +60,16 @@ void AEOSGameSession::BeginPlay()
 	// Only create a session if running as a dedicated server and session doesn't exist
 	if (IsRunningDedicatedServer() && !bSessionExists) 
 	{
-		CreateSession("KeyName", "KeyValue"); // Should parametrized Key/Value pair for custom attribute
+		RecoverSessionSnapshot(); // Picks up the session of a crashed previous server process, if there is one
+		StartReservationBeacon(); // Before CreateSession, so the beacon port can be advertised
+		CreateSession(); // Custom attributes come from the typed schema in EOSSessionAttributes
 	}
 	
 	// If we try and create a session before our user is logged in, it just fails and returns a Warning log
-	// CreateSession("KeyName", "KeyValue"); // Should parametrized Key/Value pair for custom attribute
+	// CreateSession();
 }
 
-void AEOSGameSession::CreateSession(FName KeyName, FString KeyValue)
+void AEOSGameSession::CreateSession()
 {
 	// Tutorial 3: This function will create an EOS Session.
  
@@ -38,34 +80,116 @@ void AEOSGameSession::CreateSession(FName KeyName, FString KeyValue)
     CreateSessionDelegateHandle = Session->AddOnCreateSessionCompleteDelegate_Handle(FOnCreateSessionCompleteDelegate::CreateUObject(
             this, &ThisClass::HandleCreateSessionCompleted));
  
-    // Set session settings
-	// @TODO We would populate these from a menu or something that player's can interact with and change when creating a session
-    TSharedRef<FOnlineSessionSettings> SessionSettings = MakeShared<FOnlineSessionSettings>();
-    SessionSettings->NumPublicConnections = MaxNumberOfPlayersInSession; //We will test our sessions with 2 players to keep things simple
-    SessionSettings->bShouldAdvertise = true; //This creates a public match and will be searchable. This will set the session as joinable via presence. 
-    SessionSettings->bUsesPresence = false;   //No presence on dedicated server. This requires a local user.
-    SessionSettings->bAllowJoinViaPresence = false; // superset by bShouldAdvertise and will be true on the backend
-    SessionSettings->bAllowJoinViaPresenceFriendsOnly = false; // superset by bShouldAdvertise and will be true on the backend
-    SessionSettings->bAllowInvites = false;    //Allow inviting players into session. This requires presence and a local user. 
-    SessionSettings->bAllowJoinInProgress = false; //Once the session is started, no one can join.
-    SessionSettings->bIsDedicated = true; //Session created on dedicated server.
-    SessionSettings->bUseLobbiesIfAvailable = false; //This is an EOS Session not an EOS Lobby as they aren't supported on Dedicated Servers.
-    SessionSettings->bUseLobbiesVoiceChatIfAvailable = false;
-    SessionSettings->bUsesStats = true; //Needed to keep track of player stats.
-
-	// @TODO Read up more on this custom session setting
-    // This custom attribute will be used in searches on GameClients. 
-    SessionSettings->Settings.Add(KeyName, FOnlineSessionSetting((KeyValue), EOnlineDataAdvertisementType::ViaOnlineService));
+    UpdateSessionSettings();
  
     // Create session.
     UE_LOG(LogTemp, Log, TEXT("Creating session..."));
     
-    if (!Session->CreateSession(0, SessionName, *SessionSettings))
+    if (!Session->CreateSession(0, SessionName, SessionSettings))
     {
         UE_LOG(LogTemp, Warning, TEXT("Failed to create session!"));
 		Session->ClearOnCreateSessionCompleteDelegate_Handle(CreateSessionDelegateHandle);
         CreateSessionDelegateHandle.Reset();
     }
+    else
+    {
+        // Record the id now, if we crash before the callback this is the session the next process has to re-adopt
+        SessionSnapshot.SessionId = SessionSettings.SessionIdOverride;
+        WriteSessionSnapshot(EEOSSessionLifecycle::Creating);
+    }
+}
+
+void AEOSGameSession::UpdateSessionSettings()
+{
+	// The fixed flags never change for this server, so only set them the first time round. 
+	if (!bSessionSettingsInitialized)
+	{
+		// @TODO We would populate these from a menu or something that player's can interact with and change when creating a session
+		SessionSettings.NumPublicConnections = MaxNumberOfPlayersInSession; // From config/command line, defaults to 2 players to keep things simple
+		SessionSettings.bShouldAdvertise = true; //This creates a public match and will be searchable. This will set the session as joinable via presence. 
+		SessionSettings.bUsesPresence = false;   //No presence on dedicated server. This requires a local user.
+		SessionSettings.bAllowJoinViaPresence = false; // superset by bShouldAdvertise and will be true on the backend
+		SessionSettings.bAllowJoinViaPresenceFriendsOnly = false; // superset by bShouldAdvertise and will be true on the backend
+		SessionSettings.bAllowInvites = false;    //Allow inviting players into session. This requires presence and a local user. 
+		SessionSettings.bAllowJoinInProgress = false; //Once the session is started, no one can join.
+		SessionSettings.bIsDedicated = true; //Session created on dedicated server.
+		SessionSettings.bUseLobbiesIfAvailable = false; //This is an EOS Session not an EOS Lobby as they aren't supported on Dedicated Servers.
+		SessionSettings.bUseLobbiesVoiceChatIfAvailable = false;
+		SessionSettings.bUsesStats = true; //Needed to keep track of player stats.
+
+		bSessionSettingsInitialized = true;
+	}
+
+	// We pick the session id ourselves instead of letting the backend assign one, so a restarted server can create its session with the same id again. 
+	if (SessionSettings.SessionIdOverride.IsEmpty())
+	{
+		SessionSettings.SessionIdOverride = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+	}
+
+	// These custom attributes will be used in searches on GameClients. Set overwrites the existing value, so the block can be reused. 
+	EOSSessionAttributes::ApplyServerAttributes(SessionSettings, SessionGameMode, UWorld::RemovePIEPrefix(GetWorld()->GetMapName()), IsAcceptingPlayers());
+	if (ReservationBeaconHost)
+	{
+		EOSSessionAttributes::BeaconPort.Set(SessionSettings, ReservationBeaconHost->GetListenPort());
+	}
+}
+
+bool AEOSGameSession::IsAcceptingPlayers()
+{
+	// Reserved slots count as taken, a server whose free slots are all reserved would only turn searching clients away
+	return !bMatchStartRequested && GetNumOccupiedSlots() < MaxNumberOfPlayersInSession;
+}
+
+void AEOSGameSession::RefreshAcceptingPlayers()
+{
+	bool bAdvertisedAcceptingPlayers = false;
+	EOSSessionAttributes::AcceptingPlayers.Get(SessionSettings, bAdvertisedAcceptingPlayers);
+
+	// An update that is still in flight checks again when it completes
+	if (!bSessionExists || UpdateSessionDelegateHandle.IsValid() || bAdvertisedAcceptingPlayers == IsAcceptingPlayers())
+	{
+		return;
+	}
+
+	IOnlineSubsystem* Subsystem = Online::GetSubsystem(GetWorld());
+	IOnlineSessionPtr Session = Subsystem->GetSessionInterface();
+
+	// Bind delegate to callback function
+	UpdateSessionDelegateHandle = Session->AddOnUpdateSessionCompleteDelegate_Handle(FOnUpdateSessionCompleteDelegate::CreateUObject(
+		this, &ThisClass::HandleUpdateSessionCompleted));
+
+	// Same settings block as CreateSession, only the attribute values change
+	UpdateSessionSettings();
+
+	if (!Session->UpdateSession(SessionName, SessionSettings, true))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to update session!"));
+		Session->ClearOnUpdateSessionCompleteDelegate_Handle(UpdateSessionDelegateHandle);
+		UpdateSessionDelegateHandle.Reset();
+	}
+}
+
+void AEOSGameSession::HandleUpdateSessionCompleted(FName EOSSessionName, bool bWasSuccessful)
+{
+	IOnlineSubsystem* Subsystem = Online::GetSubsystem(GetWorld());
+	IOnlineSessionPtr Session = Subsystem->GetSessionInterface();
+
+	if (bWasSuccessful)
+	{
+		bool bAdvertisedAcceptingPlayers = false;
+		EOSSessionAttributes::AcceptingPlayers.Get(SessionSettings, bAdvertisedAcceptingPlayers);
+		UE_LOG(LogTemp, Log, TEXT("Session updated, %s players."), bAdvertisedAcceptingPlayers ? TEXT("accepting") : TEXT("not accepting"));
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to update session! (From Callback)"));
+	}
+
+	Session->ClearOnUpdateSessionCompleteDelegate_Handle(UpdateSessionDelegateHandle);
+	UpdateSessionDelegateHandle.Reset();
+
+	// Players may have joined or left while the update was in flight
+	RefreshAcceptingPlayers();
 }
 
 void AEOSGameSession::HandleCreateSessionCompleted(FName EOSSessionName, bool bWasSuccessful)
@@ -74,20 +198,393 @@ void AEOSGameSession::HandleCreateSessionCompleted(FName EOSSessionName, bool bW
 	IOnlineSubsystem* Subsystem = Online::GetSubsystem(GetWorld());
 	IOnlineSessionPtr Session = Subsystem->GetSessionInterface(); // Retrieve the generic session interface. 
  
-	// Nothing special here, simply log that the session is created.
+	// Creating the session of a leaked id for cleanup fires this as well
+	if (EOSSessionName != SessionName)
+	{
+		return;
+	}
+
+	// Clear our handle and reset the delegate first, recovering may need to call CreateSession again. 
+	Session->ClearOnCreateSessionCompleteDelegate_Handle(CreateSessionDelegateHandle);
+	CreateSessionDelegateHandle.Reset();
+
 	if (bWasSuccessful)
 	{
 		bSessionExists = true; 
 		UE_LOG(LogTemp, Log, TEXT("Session: %s Created!"), *EOSSessionName.ToString());
+
+		const FNamedOnlineSession* NamedSession = Session->GetNamedSession(EOSSessionName);
+		SessionSnapshot.SessionId = NamedSession ? NamedSession->GetSessionIdStr() : SessionSettings.SessionIdOverride;
+		WriteSessionSnapshot(EEOSSessionLifecycle::Created);
+
+		// Our own session is up, now try to get rid of the ones earlier processes left behind
+		StartLeakedSessionCleanup();
+	}
+	else if (bRecoveringSession)
+	{
+		// The backend wouldn't let us take the old session over (yet), so it stays there next to the new one. Keep its id in
+		// the snapshot, the leaked session cleanup keeps trying to take it over and destroy it.
+		UE_LOG(LogTemp, Warning, TEXT("Failed to re-adopt session %s, creating a new one. The old one is cleaned up later."), *SessionSettings.SessionIdOverride);
+		SessionSnapshot.AddLeakedSessionId(SessionSettings.SessionIdOverride);
+		bRecoveringSession = false;
+		SessionSettings.SessionIdOverride.Reset();
+		CreateSession();
+		return;
 	}
 	else
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Failed to create session!"));
+		WriteSessionSnapshot(EEOSSessionLifecycle::None);
 	}
- 
-	// Clear our handle and reset the delegate. 
-	Session->ClearOnCreateSessionCompleteDelegate_Handle(CreateSessionDelegateHandle);
-	CreateSessionDelegateHandle.Reset();
+
+	bRecoveringSession = false;
+}
+
+void AEOSGameSession::RecoverSessionSnapshot()
+{
+	const FString SnapshotPath = FEOSSessionSnapshotFile::GetSnapshotPath(GetWorld()->URL.Port);
+
+	FEOSSessionSnapshot PreviousSnapshot;
+	if (!FEOSSessionSnapshotFile::Load(SnapshotPath, PreviousSnapshot))
+	{
+		PreviousSnapshot = FEOSSessionSnapshot();
+	}
+
+	for (const FString& LeakedSessionId : PreviousSnapshot.LeakedSessionIds)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Session %s of an earlier server process is still leaked on the backend, cleaning it up once our session is created."), *LeakedSessionId);
+	}
+
+	const FString CurrentMapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	if (PreviousSnapshot.NeedsRecovery() && PreviousSnapshot.MapName != CurrentMapName)
+	{
+		// The old session advertises another map than this process runs, taking it over would send players to the wrong map
+		UE_LOG(LogTemp, Warning, TEXT("Previous server process left session %s on map %s, this process runs %s. Cleaning it up instead of re-adopting it."),
+			*PreviousSnapshot.SessionId, *PreviousSnapshot.MapName, *CurrentMapName);
+		if (!PreviousSnapshot.SessionId.IsEmpty())
+		{
+			PreviousSnapshot.AddLeakedSessionId(PreviousSnapshot.SessionId);
+		}
+	}
+	else if (PreviousSnapshot.NeedsRecovery())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Previous server process left session %s %s with %d registered player(s) (snapshot from %s). Re-adopting it."),
+			*PreviousSnapshot.SessionId, FEOSSessionSnapshot::LexToString(PreviousSnapshot.Lifecycle), PreviousSnapshot.RegisteredPlayerIds.Num(),
+			*FDateTime::FromUnixTimestamp(PreviousSnapshot.WrittenAt).ToString());
+
+		// Create the session again with the old id and settings, so the orphaned backend entry is taken over instead of left next to a new one.
+		// Clients searching for it find this server again, and the registered players are re-registered as they reconnect.
+		SessionGameMode = PreviousSnapshot.GameMode;
+		if (PreviousSnapshot.MaxPlayers > 0 && PreviousSnapshot.MaxPlayers != MaxNumberOfPlayersInSession)
+		{
+			SetSessionCapacity(PreviousSnapshot.MaxPlayers); // Same capacity as the session we take over, not whatever this process is configured with
+		}
+		SessionSettings.SessionIdOverride = PreviousSnapshot.SessionId;
+		bRecoveringSession = !PreviousSnapshot.SessionId.IsEmpty();
+	}
+
+	SessionSnapshot = FEOSSessionSnapshot();
+	SessionSnapshot.LeakedSessionIds = MoveTemp(PreviousSnapshot.LeakedSessionIds);
+	SessionSnapshotFile.Open(SnapshotPath);
+}
+
+void AEOSGameSession::StartLeakedSessionCleanup()
+{
+	if (SessionSnapshot.LeakedSessionIds.Num() == 0 || GetWorldTimerManager().IsTimerActive(LeakedSessionCleanupTimerHandle))
+	{
+		return;
+	}
+
+	GetWorldTimerManager().SetTimer(LeakedSessionCleanupTimerHandle, this, &ThisClass::CleanUpLeakedSession, LeakedSessionCleanupInterval, true, 0.f);
+}
+
+void AEOSGameSession::CleanUpLeakedSession()
+{
+	if (SessionSnapshot.LeakedSessionIds.Num() == 0)
+	{
+		GetWorldTimerManager().ClearTimer(LeakedSessionCleanupTimerHandle);
+		return;
+	}
+
+	// One at a time, the previous attempt is still in flight
+	if (CleanupCreateSessionDelegateHandle.IsValid() || CleanupDestroySessionDelegateHandle.IsValid())
+	{
+		return;
+	}
+
+	IOnlineSubsystem* Subsystem = Online::GetSubsystem(GetWorld());
+	IOnlineSessionPtr Session = Subsystem->GetSessionInterface();
+
+	// We can only destroy a session we own. Take the leaked one over by creating it with its id under a second, unadvertised name,
+	// then destroy that. The backend refuses the create while it still holds the old session for the crashed process, so retry.
+	CleanupSessionId = SessionSnapshot.LeakedSessionIds[0];
+
+	FOnlineSessionSettings CleanupSettings = SessionSettings;
+	CleanupSettings.SessionIdOverride = CleanupSessionId;
+	CleanupSettings.bShouldAdvertise = false;
+
+	// Bind delegate to callback function
+	CleanupCreateSessionDelegateHandle = Session->AddOnCreateSessionCompleteDelegate_Handle(FOnCreateSessionCompleteDelegate::CreateUObject(
+		this, &ThisClass::HandleLeakedSessionCreated));
+
+	if (!Session->CreateSession(0, LeakedSessionName, CleanupSettings))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to take over leaked session %s!"), *CleanupSessionId);
+		Session->ClearOnCreateSessionCompleteDelegate_Handle(CleanupCreateSessionDelegateHandle);
+		CleanupCreateSessionDelegateHandle.Reset();
+	}
+}
+
+void AEOSGameSession::HandleLeakedSessionCreated(FName EOSSessionName, bool bWasSuccessful)
+{
+	if (EOSSessionName != LeakedSessionName)
+	{
+		return;
+	}
+
+	IOnlineSubsystem* Subsystem = Online::GetSubsystem(GetWorld());
+	IOnlineSessionPtr Session = Subsystem->GetSessionInterface();
+
+	Session->ClearOnCreateSessionCompleteDelegate_Handle(CleanupCreateSessionDelegateHandle);
+	CleanupCreateSessionDelegateHandle.Reset();
+
+	if (!bWasSuccessful)
+	{
+		// Still held by the backend. Move it to the back so the other leaked sessions get their turn.
+		UE_LOG(LogTemp, Log, TEXT("Leaked session %s can't be taken over yet, retrying in %.0f s."), *CleanupSessionId, LeakedSessionCleanupInterval);
+		if (SessionSnapshot.LeakedSessionIds.Remove(CleanupSessionId) > 0)
+		{
+			SessionSnapshot.LeakedSessionIds.Add(CleanupSessionId);
+		}
+		return;
+	}
+
+	// Bind delegate to callback function
+	CleanupDestroySessionDelegateHandle = Session->AddOnDestroySessionCompleteDelegate_Handle(FOnDestroySessionCompleteDelegate::CreateUObject(
+		this, &ThisClass::HandleLeakedSessionDestroyed));
+
+	if (!Session->DestroySession(LeakedSessionName))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to destroy leaked session %s!"), *CleanupSessionId);
+		Session->ClearOnDestroySessionCompleteDelegate_Handle(CleanupDestroySessionDelegateHandle);
+		CleanupDestroySessionDelegateHandle.Reset();
+	}
+}
+
+void AEOSGameSession::HandleLeakedSessionDestroyed(FName EOSSessionName, bool bWasSuccessful)
+{
+	if (EOSSessionName != LeakedSessionName)
+	{
+		return;
+	}
+
+	IOnlineSubsystem* Subsystem = Online::GetSubsystem(GetWorld());
+	IOnlineSessionPtr Session = Subsystem->GetSessionInterface();
+
+	if (bWasSuccessful)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Leaked session %s cleaned up."), *CleanupSessionId);
+		SessionSnapshot.LeakedSessionIds.Remove(CleanupSessionId);
+		WriteSessionSnapshot(SessionSnapshot.Lifecycle);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to destroy leaked session %s! (From Callback)"), *CleanupSessionId);
+	}
+
+	Session->ClearOnDestroySessionCompleteDelegate_Handle(CleanupDestroySessionDelegateHandle);
+	CleanupDestroySessionDelegateHandle.Reset();
+}
+
+void AEOSGameSession::WriteSessionSnapshot(EEOSSessionLifecycle Lifecycle)
+{
+	SessionSnapshot.Lifecycle = Lifecycle;
+	SessionSnapshot.GameMode = SessionGameMode;
+	EOSSessionAttributes::MapName.Get(SessionSettings, SessionSnapshot.MapName);
+	SessionSnapshot.MaxPlayers = SessionSettings.NumPublicConnections;
+
+	SessionSnapshotFile.Write(SessionSnapshot);
+}
+
+void AEOSGameSession::StartReservationBeacon()
+{
+	if (!bEnableReservationBeacon || ReservationBeaconHost)
+	{
+		return;
+	}
+
+	// The beacon has its own (IP) net driver and port, set in the OnlineBeaconHost section of DefaultEngine.ini
+	ReservationBeaconHost = GetWorld()->SpawnActor<AOnlineBeaconHost>();
+	if (!ReservationBeaconHost || !ReservationBeaconHost->InitHost())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to start reservation beacon!"));
+		if (ReservationBeaconHost)
+		{
+			ReservationBeaconHost->Destroy();
+			ReservationBeaconHost = nullptr;
+		}
+		return;
+	}
+
+	ReservationBeaconHostObject = GetWorld()->SpawnActor<AEOSReservationBeaconHostObject>();
+	ReservationBeaconHostObject->SetGameSession(this);
+	ReservationBeaconHost->RegisterHost(ReservationBeaconHostObject);
+	ReservationBeaconHost->PauseBeaconRequests(false);
+
+	UE_LOG(LogTemp, Log, TEXT("Reservation beacon listening on port %d."), ReservationBeaconHost->GetListenPort());
+}
+
+void AEOSGameSession::StopReservationBeacon()
+{
+	if (ReservationBeaconHost)
+	{
+		if (ReservationBeaconHostObject)
+		{
+			ReservationBeaconHost->UnregisterHost(ReservationBeaconHostObject->GetBeaconType());
+			ReservationBeaconHostObject->Destroy();
+			ReservationBeaconHostObject = nullptr;
+		}
+
+		ReservationBeaconHost->DestroyBeacon();
+		ReservationBeaconHost = nullptr;
+	}
+
+	GetWorldTimerManager().ClearTimer(ReservationTimerHandle);
+	SlotReservations.Reset();
+}
+
+int AEOSGameSession::GetNumOccupiedSlots()
+{
+	RemoveExpiredReservations();
+
+	// Players that passed ApproveLogin but haven't finished registering are only counted by the game mode yet
+	AGameModeBase* GameMode = GetWorld()->GetAuthGameMode();
+	int NumOccupiedSlots = FMath::Max(NumberOfPlayersInSession, GameMode ? GameMode->GetNumPlayers() : 0);
+
+	for (const FEOSSlotReservation& Reservation : SlotReservations)
+	{
+		NumOccupiedSlots += Reservation.NumSlots;
+	}
+
+	return NumOccupiedSlots;
+}
+
+bool AEOSGameSession::TryReserveSlots(int32 NumSlots, FString& OutToken)
+{
+	// Nobody can join once the match started, so there is nothing to reserve. One request can't take more than a party's worth of slots.
+	if (NumSlots <= 0 || NumSlots > FMath::Min(MaxSlotsPerReservation, MaxNumberOfPlayersInSession) || bMatchStartRequested
+		|| GetNumOccupiedSlots() + NumSlots > MaxNumberOfPlayersInSession)
+	{
+		return false;
+	}
+
+	FEOSSlotReservation& Reservation = SlotReservations.AddDefaulted_GetRef();
+	Reservation.Token = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+	Reservation.NumSlots = NumSlots;
+	Reservation.ExpiresAt = GetWorld()->GetRealTimeSeconds() + ReservationTimeout;
+
+	OutToken = Reservation.Token;
+
+	UE_LOG(LogTemp, Log, TEXT("Reserved %d slot(s), %d/%d slots taken."), NumSlots, GetNumOccupiedSlots(), MaxNumberOfPlayersInSession);
+
+	// Watch for the reservation expiring, its slots become free again then
+	if (!GetWorldTimerManager().IsTimerActive(ReservationTimerHandle))
+	{
+		GetWorldTimerManager().SetTimer(ReservationTimerHandle, this, &ThisClass::UpdateReservations, 1.f, true);
+	}
+
+	RefreshAcceptingPlayers(); // Stop advertising once every free slot is reserved
+	return true;
+}
+
+bool AEOSGameSession::ClaimReservationSlot(const FString& Token)
+{
+	RemoveExpiredReservations();
+
+	FEOSSlotReservation* Reservation = SlotReservations.FindByPredicate([&Token](const FEOSSlotReservation& Candidate) { return Candidate.Token == Token; });
+	if (!Reservation || Reservation->NumClaimedSlots >= Reservation->NumSlots)
+	{
+		return false;
+	}
+
+	// The slot stays counted while the player loads the map, that can take longer than the reservation was held for
+	Reservation->NumClaimedSlots++;
+	Reservation->ExpiresAt = FMath::Max(Reservation->ExpiresAt, GetWorld()->GetRealTimeSeconds() + ClaimedReservationTimeout);
+
+	return true;
+}
+
+void AEOSGameSession::CompleteReservationSlot(const FString& Token)
+{
+	const int32 Index = SlotReservations.IndexOfByPredicate([&Token](const FEOSSlotReservation& Reservation) { return Reservation.Token == Token; });
+	if (Index == INDEX_NONE || SlotReservations[Index].NumClaimedSlots <= 0)
+	{
+		return;
+	}
+
+	// The game mode counts the player from now on, parties keep the rest of their slots
+	FEOSSlotReservation& Reservation = SlotReservations[Index];
+	Reservation.NumClaimedSlots--;
+	if (--Reservation.NumSlots <= 0)
+	{
+		SlotReservations.RemoveAtSwap(Index);
+	}
+}
+
+void AEOSGameSession::RemoveExpiredReservations()
+{
+	const double Now = GetWorld()->GetRealTimeSeconds();
+	SlotReservations.RemoveAllSwap([Now](const FEOSSlotReservation& Reservation) { return Reservation.ExpiresAt <= Now; });
+}
+
+void AEOSGameSession::CancelOpenReservations()
+{
+	// Claimed slots already passed ApproveLogin, their players are let in
+	for (FEOSSlotReservation& Reservation : SlotReservations)
+	{
+		Reservation.NumSlots = Reservation.NumClaimedSlots;
+	}
+	SlotReservations.RemoveAllSwap([](const FEOSSlotReservation& Reservation) { return Reservation.NumSlots <= 0; });
+
+	RefreshAcceptingPlayers();
+}
+
+void AEOSGameSession::UpdateReservations()
+{
+	RemoveExpiredReservations();
+	if (SlotReservations.Num() == 0)
+	{
+		GetWorldTimerManager().ClearTimer(ReservationTimerHandle);
+	}
+
+	RefreshAcceptingPlayers(); // Expired reservations may have freed slots
+}
+
+FString AEOSGameSession::ApproveLogin(const FString& Options)
+{
+	if (IsRunningDedicatedServer())
+	{
+		// The session doesn't allow joining in progress, with or without a reservation
+		if (bMatchStartRequested)
+		{
+			return TEXT("Match already started.");
+		}
+
+		// A reservation already holds a slot for this player. It stays taken until the player has loaded in, see CompleteReservationSlot.
+		const FString ReservationToken = UGameplayStatics::ParseOption(Options, TEXT("Reservation"));
+		if (!ReservationToken.IsEmpty() && ClaimReservationSlot(ReservationToken))
+		{
+			return Super::ApproveLogin(Options);
+		}
+
+		// Everyone else can only take a slot nobody has reserved
+		if (GetNumOccupiedSlots() >= MaxNumberOfPlayersInSession)
+		{
+			return TEXT("Server full.");
+		}
+	}
+
+	return Super::ApproveLogin(Options);
 }
 
 bool AEOSGameSession::ProcessAutoLogin()
@@ -117,9 +614,32 @@ void AEOSGameSession::RegisterPlayer(APlayerController* NewPlayer, const FUnique
 			Session->ClearOnRegisterPlayersCompleteDelegate_Handle(RegisterPlayerDelegateHandle);
 			RegisterPlayerDelegateHandle.Reset();
 		}
+
+		// Start sampling this player's connection. The timer runs until the last player leaves.
+		NetTelemetry.AddConnection(UniqueId, NewPlayer);
+		if (!GetWorldTimerManager().IsTimerActive(NetTelemetryTimerHandle))
+		{
+			GetWorldTimerManager().SetTimer(NetTelemetryTimerHandle, this, &ThisClass::SampleNetTelemetry, NetTelemetrySampleInterval, true);
+		}
 	}    
 }
 
+void AEOSGameSession::SampleNetTelemetry()
+{
+	NetTelemetry.Sample();
+}
+
+void AEOSGameSession::FinishNetTelemetry()
+{
+	// Everyone has left, report how their connections did and start fresh for the next players
+	GetWorldTimerManager().ClearTimer(NetTelemetryTimerHandle);
+	if (!NetTelemetry.IsEmpty())
+	{
+		NetTelemetry.LogSummary();
+		NetTelemetry.Reset();
+	}
+}
+
 void AEOSGameSession::HandleRegisterPlayerCompleted(FName EOSSessionName, const TArray<FUniqueNetIdRef>& PlayerIds, bool bWasSuccesful)
 {
 	// Tutorial 3: This function is triggered via the callback we set in RegisterPlayer once the player is registered (or there is a failure)
@@ -129,13 +649,30 @@ void AEOSGameSession::HandleRegisterPlayerCompleted(FName EOSSessionName, const
 	if (bWasSuccesful)
 	{
 		UE_LOG(LogTemp, Log, TEXT("Player registered in EOS Session!"));
+		for (const FUniqueNetIdRef& PlayerId : PlayerIds)
+		{
+			SessionSnapshot.RegisteredPlayerIds.AddUnique(PlayerId->ToString());
+		}
+		WriteSessionSnapshot(SessionSnapshot.Lifecycle);
+
 		NumberOfPlayersInSession++; // Keep track of players registered in session 
-		if (NumberOfPlayersInSession == MaxNumberOfPlayersInSession)
+
+		// Queue the players for the match start. The scheduler starts the match when full, when its countdown runs out or on its hard timeout
+		if (!bMatchStartRequested)
 		{
-			// We might not necessarily want to start our session when we have reached the player cap but rather when
-			// the player decides to e.g. pushing a button or what not
-			StartSession(); // Start the session when we've reached the max number of players 
+			for (const FUniqueNetIdRef& PlayerId : PlayerIds)
+			{
+				MatchStartScheduler.AddPlayer(PlayerId->ToString(), GetWorld()->GetRealTimeSeconds());
+			}
+
+			if (!GetWorldTimerManager().IsTimerActive(MatchStartTimerHandle))
+			{
+				GetWorldTimerManager().SetTimer(MatchStartTimerHandle, this, &ThisClass::EvaluateMatchStart, 1.f, true);
+			}
+			EvaluateMatchStart();
 		}
+
+		RefreshAcceptingPlayers(); // Stop advertising once full
 	}
 	else
 	{
@@ -147,9 +684,39 @@ void AEOSGameSession::HandleRegisterPlayerCompleted(FName EOSSessionName, const
 	RegisterPlayerDelegateHandle.Reset();
 }
 
+void AEOSGameSession::EvaluateMatchStart()
+{
+	const double Now = GetWorld()->GetRealTimeSeconds();
+
+	if (MatchStartScheduler.GetNumQueuedPlayers() == 0)
+	{
+		// Nobody waiting, the timer is restarted when the next player registers
+		GetWorldTimerManager().ClearTimer(MatchStartTimerHandle);
+		return;
+	}
+
+	if (!MatchStartScheduler.ShouldStart(Now))
+	{
+		const double RemainingCountdown = MatchStartScheduler.GetRemainingCountdown(Now);
+		if (RemainingCountdown >= 0.0)
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("Match starts in %.0f s (%d/%d players)."), RemainingCountdown, MatchStartScheduler.GetNumQueuedPlayers(), MaxNumberOfPlayersInSession);
+		}
+		return;
+	}
+
+	GetWorldTimerManager().ClearTimer(MatchStartTimerHandle);
+	MatchStartScheduler.LogQueueWaitTimes(Now);
+	bMatchStartRequested = true;
+	CancelOpenReservations();
+
+	StartSession();
+	RefreshAcceptingPlayers(); // Nobody can join once the match starts
+}
+
 void AEOSGameSession::StartSession()
 {
-	// Tutorial 3: This function is called once all players are registered. It will mark the EOS Session as started. 
+	// Tutorial 3: This function is called once the match start scheduler decides the match should start. It will mark the EOS Session as started. 
 	IOnlineSubsystem* Subsystem = Online::GetSubsystem(GetWorld());
 	IOnlineSessionPtr Session = Subsystem->GetSessionInterface();
  
@@ -165,6 +732,11 @@ void AEOSGameSession::StartSession()
 		UE_LOG(LogTemp, Warning, TEXT("Failed to start session!"));
 		Session->ClearOnStartSessionCompleteDelegate_Handle(StartSessionDelegateHandle);
 		StartSessionDelegateHandle.Reset();		
+
+		// Let the scheduler try again on its next evaluation
+		bMatchStartRequested = false;
+		GetWorldTimerManager().SetTimer(MatchStartTimerHandle, this, &ThisClass::EvaluateMatchStart, 1.f, true);
+		RefreshAcceptingPlayers();
 	}
 }
 
@@ -178,10 +750,17 @@ void AEOSGameSession::HandleStartSessionCompleted(FName MySessionName, bool bWas
 	if (bWasSuccessful)
 	{
 		UE_LOG(LogTemp, Log, TEXT("Session Started!"));
+		WriteSessionSnapshot(EEOSSessionLifecycle::Started);
+		MatchStartScheduler.Reset();
 	}
 	else
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Failed to start session! (From Callback)"));
+
+		// Let the scheduler try again on its next evaluation
+		bMatchStartRequested = false;
+		GetWorldTimerManager().SetTimer(MatchStartTimerHandle, this, &ThisClass::EvaluateMatchStart, 1.f, true);
+		RefreshAcceptingPlayers();
 	}
  
 	Session->ClearOnStartSessionCompleteDelegate_Handle(StartSessionDelegateHandle);
@@ -233,11 +812,21 @@ void AEOSGameSession::NotifyLogout(const APlayerController* PC)
 	// When players leave the dedicated server we need to check how many players are left. If 0 players are left, session is destroyed.  
 	if (IsRunningDedicatedServer())
 	{
+		// Stop waiting for this player right away. The unregister callback doesn't come if the player left without a PlayerState or the unregister failed.
+		const FUniqueNetIdRepl PlayerId = GetPlayerUniqueId(PC);
+		if (PlayerId.IsValid())
+		{
+			MatchStartScheduler.RemovePlayer(PlayerId.ToString(), GetWorld()->GetRealTimeSeconds());
+		}
+
 		NumberOfPlayersInSession--; // Keep track of players as they leave
+		RefreshAcceptingPlayers(); // A slot may have opened up again
         
 		// No one left in server - end session if session is InProgress
 		if (NumberOfPlayersInSession==0)
 		{
+			FinishNetTelemetry(); // Whether or not the match ever started
+
 			IOnlineSubsystem* Subsystem = Online::GetSubsystem(GetWorld());
 			IOnlineSessionPtr Session = Subsystem->GetSessionInterface();
 			
@@ -254,10 +843,29 @@ void AEOSGameSession::NotifyLogout(const APlayerController* PC)
 	}
 }
 
+FUniqueNetIdRepl AEOSGameSession::GetPlayerUniqueId(const APlayerController* PC)
+{
+	if (!PC)
+	{
+		return FUniqueNetIdRepl();
+	}
+
+	if (PC->PlayerState)
+	{
+		return PC->PlayerState->GetUniqueId();
+	}
+
+	// Without a PlayerState the id the player logged in with is still on the connection
+	const UNetConnection* Connection = PC->GetNetConnection();
+	return Connection ? Connection->PlayerId : FUniqueNetIdRepl();
+}
+
 void AEOSGameSession::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	FinishNetTelemetry(); // Server shutting down with players still connected
+	StopReservationBeacon();
 	DestroySession();
 }
 
@@ -272,6 +880,11 @@ void AEOSGameSession::HandleUnregisterPlayerCompleted(FName EOSSessionName, cons
 	if (bWasSuccesful)
 	{
 		UE_LOG(LogTemp, Log, TEXT("Player unregistered in EOS Session!"));
+		for (const FUniqueNetIdRef& PlayerId : PlayerIds)
+		{
+			SessionSnapshot.RegisteredPlayerIds.Remove(PlayerId->ToString());
+		}
+		WriteSessionSnapshot(SessionSnapshot.Lifecycle);
 	}
 	else
 	{
@@ -286,7 +899,7 @@ void AEOSGameSession::EndSession()
 	// Tutorial 3: This function is called once all players have left the session. It will mark the EOS Session as ended. 
 	IOnlineSubsystem* Subsystem = Online::GetSubsystem(GetWorld());
 	IOnlineSessionPtr Session = Subsystem->GetSessionInterface();
- 
+
 	// Bind delegate to callback function
 	EndSessionDelegateHandle =
 		Session->AddOnEndSessionCompleteDelegate_Handle(FOnEndSessionCompleteDelegate::CreateUObject(
@@ -311,6 +924,13 @@ void AEOSGameSession::HandleEndSessionCompleted(FName EOSSessionName, bool bWasS
 	if (bWasSuccessful)
 	{
 		UE_LOG(LogTemp, Log, TEXT("Session ended!"));
+		WriteSessionSnapshot(EEOSSessionLifecycle::Ended);
+
+		// The session can be started again, the next players queue up for a new match
+		bMatchStartRequested = false;
+		MatchStartScheduler.Reset();
+		GetWorldTimerManager().ClearTimer(MatchStartTimerHandle);
+		RefreshAcceptingPlayers(); // Advertise the server as joinable again
 	}
 	else
 	{
@@ -343,6 +963,12 @@ void AEOSGameSession::HandleDestroySessionCompleted(FName EOSSessionName, bool b
 {
 	// Tutorial 3: This function is triggered via the callback we set in DestroySession once the session is destroyed (or there is a failure).
  
+	// Destroying a leaked session during cleanup fires this as well
+	if (EOSSessionName != SessionName)
+	{
+		return;
+	}
+
 	IOnlineSubsystem* Subsystem = Online::GetSubsystem(GetWorld());
 	IOnlineSessionPtr Session = Subsystem->GetSessionInterface();
  
@@ -350,6 +976,9 @@ void AEOSGameSession::HandleDestroySessionCompleted(FName EOSSessionName, bool b
 	{
 		bSessionExists = false; // Mark that the session doesn't exist. This way next time BeginPlay is called a new session will be created. 
 		UE_LOG(LogTemp, Log, TEXT("Destroyed session succesfully.")); 
+		SessionSnapshot.RegisteredPlayerIds.Reset();
+		WriteSessionSnapshot(EEOSSessionLifecycle::Destroyed); // Nothing left to recover
+		SessionSettings.SessionIdOverride.Reset(); // A new session gets a new id
 	}
 	else
 	{
@@ -5,12 +5,36 @@
 #include "CoreMinimal.h"
 #include "GameFramework/GameSession.h"
 #include "Interfaces/OnlineSessionDelegates.h"
+#include "OnlineSessionSettings.h"
+#include "EOSSessionAttributes.h"
+#include "EOSNetTelemetry.h"
+#include "EOSSessionSnapshot.h"
+#include "EOSMatchStartScheduler.h"
 #include "EOSGameSession.generated.h"
 
+class AOnlineBeaconHost;
+class AEOSReservationBeaconHostObject;
+
+/**
+ * Slots held for a client (or party) that asked the reservation beacon for them and hasn't joined yet.
+ */
+struct FEOSSlotReservation
+{
+	FString Token;
+
+	// Slots still held, claimed ones included. A slot is only released once its player has logged in and is counted by the game mode. 
+	int32 NumSlots = 0;
+
+	// Slots whose player passed ApproveLogin and is loading the map. 
+	int32 NumClaimedSlots = 0;
+
+	double ExpiresAt = 0.0;
+};
+
 /**
  * 
  */
-UCLASS()
+UCLASS(config=Game)
 class EOS_OSS_TUTORIAL_API AEOSGameSession : public AGameSession
 {
 	GENERATED_BODY()
@@ -35,23 +59,174 @@ private:
 	// Delegate to bind callback event for destroy session. 
 	FDelegateHandle DestroySessionDelegateHandle; 
 
+	// Delegate to bind callback event for update session. 
+	FDelegateHandle UpdateSessionDelegateHandle;
+
 	// Used to keep track if the session exists or not. 
 	bool bSessionExists = false;
 
-	// Hardcoding the max number of players in a session. 
-	const int MaxNumberOfPlayersInSession = 2;
+	// Max number of players in a session. Set in DefaultGame.ini, with ?MaxPlayers= in the map URL or with -MaxPlayersInSession= on the command line. 
+	UPROPERTY(config)
+	int32 MaxNumberOfPlayersInSession = 2;
+
+	// Match start policy, see FEOSMatchStartSettings. Each can be overridden on the command line, e.g. -MinPlayersToStart=2. 
+	UPROPERTY(config)
+	int32 MinPlayersToStart = 1;
+
+	UPROPERTY(config)
+	float MaxStartCountdown = 30.f;
+
+	UPROPERTY(config)
+	float MinStartCountdown = 5.f;
+
+	UPROPERTY(config)
+	float StartHardTimeout = 120.f;
 
 	int NumberOfPlayersInSession = 0;
 
+	// Game mode advertised through the session attribute schema. 
+	EEOSSessionGameMode SessionGameMode = EEOSSessionGameMode::ThirdPerson;
+
+	// Settings block reused by every CreateSession call. The fixed flags are set once, only attribute values are refreshed. 
+	FOnlineSessionSettings SessionSettings;
+
+	bool bSessionSettingsInitialized = false;
+
+	// Per-connection RTT, jitter, loss and bandwidth of the registered players. Summarised when the last player leaves. 
+	FEOSNetTelemetry NetTelemetry;
+
+	FTimerHandle NetTelemetryTimerHandle;
+
+	// How often the player connections are sampled, in seconds. 
+	static constexpr float NetTelemetrySampleInterval = 1.f;
+
+	// Session state written to disk on every lifecycle transition, so a restarted server can re-adopt its session after a crash. 
+	FEOSSessionSnapshot SessionSnapshot;
+
+	FEOSSessionSnapshotFile SessionSnapshotFile;
+
+	// Decides when the session starts based on the players queued in it. 
+	FEOSMatchStartScheduler MatchStartScheduler;
+
+	FTimerHandle MatchStartTimerHandle;
+
+	bool bMatchStartRequested = false;
+
+	// How long a reservation holds its slots for the client to travel, in seconds. 
+	UPROPERTY(config)
+	float ReservationTimeout = 30.f;
+
+	// How long a claimed slot is held for its player to load the map and log in, in seconds. 
+	UPROPERTY(config)
+	float ClaimedReservationTimeout = 120.f;
+
+	// Most slots one reservation request can take, i.e. the largest party. 
+	UPROPERTY(config)
+	int32 MaxSlotsPerReservation = 4;
+
+	UPROPERTY(config)
+	bool bEnableReservationBeacon = true;
+
+	// Listens for reservation requests from clients before they do a full connect. 
+	UPROPERTY()
+	TObjectPtr<AOnlineBeaconHost> ReservationBeaconHost;
+
+	UPROPERTY()
+	TObjectPtr<AEOSReservationBeaconHostObject> ReservationBeaconHostObject;
+
+	TArray<FEOSSlotReservation> SlotReservations;
+
+	// Runs while there are reservations, to notice when they expire. 
+	FTimerHandle ReservationTimerHandle;
+
+	// True while creating a session that takes over the one a crashed previous process left behind. 
+	bool bRecoveringSession = false;
+
+	// How often (s) to retry taking over and destroying sessions earlier processes leaked on the backend. 
+	UPROPERTY(config)
+	float LeakedSessionCleanupInterval = 60.f;
+
+	// Name the leaked session being cleaned up is created under locally, next to our own SessionName. 
+	const FName LeakedSessionName = FName(TEXT("LeakedSession"));
+
+	// Id of the leaked session currently being cleaned up. 
+	FString CleanupSessionId;
+
+	FTimerHandle LeakedSessionCleanupTimerHandle;
+
+	FDelegateHandle CleanupCreateSessionDelegateHandle;
+	FDelegateHandle CleanupDestroySessionDelegateHandle;
+
+public:
+
+	int GetMaxNumberOfPlayersInSession() const { return MaxNumberOfPlayersInSession; }
+
+	// Players in the session plus slots held by reservations. 
+	int GetNumOccupiedSlots();
+
+	// Holds NumSlots slots for ReservationTimeout seconds if they are free. The client passes OutToken in its travel URL as ?Reservation=. 
+	bool TryReserveSlots(int32 NumSlots, FString& OutToken);
+
+	// Called from the game mode's Login once the player is counted there. Releases the claimed slot of the reservation with this token. 
+	void CompleteReservationSlot(const FString& Token);
+
 protected:
 
+	virtual void InitOptions(const FString& Options) override;
+
+	// Sets the session and engine capacity and configures the match start policy for it. 
+	void SetSessionCapacity(int32 Capacity);
+
 	virtual void BeginPlay() override;
 
 	// Function to create an EOS session. 
-	void CreateSession(FName KeyName = "KeyName", FString KeyValue= "KeyValue");
+	void CreateSession();
+
+	// Fills SessionSettings with the fixed session flags and the typed attributes from EOSSessionAttributes. 
+	void UpdateSessionSettings();
+
+	// True until every slot is taken or reserved, or the match has started. 
+	bool IsAcceptingPlayers();
+
+	// Pushes the AcceptingPlayers attribute to the backend with UpdateSession if it no longer matches IsAcceptingPlayers. 
+	void RefreshAcceptingPlayers();
+
+	// Checks for a snapshot left by a previous server process and, if its session was never destroyed, sets up to re-adopt it. 
+	void RecoverSessionSnapshot();
+
+	void WriteSessionSnapshot(EEOSSessionLifecycle Lifecycle);
+
+	// Starts retrying CleanUpLeakedSession on a timer if the snapshot lists leaked sessions. 
+	void StartLeakedSessionCleanup();
+
+	// Takes the first leaked session over by creating it with its id, then destroys it. Stops the timer once none are left. 
+	void CleanUpLeakedSession();
+
+	void HandleLeakedSessionCreated(FName EOSSessionName, bool bWasSuccessful);
+
+	void HandleLeakedSessionDestroyed(FName EOSSessionName, bool bWasSuccessful);
+
+	void StartReservationBeacon();
+
+	void StopReservationBeacon();
+
+	// Marks one slot of the reservation with this token as claimed by a player that is about to load in. The slot stays occupied
+	// until CompleteReservationSlot. Returns false if there is no such (unexpired) reservation or all its slots are claimed. 
+	bool ClaimReservationSlot(const FString& Token);
+
+	void RemoveExpiredReservations();
+
+	// Drops every reservation nobody has claimed yet. Called when the match starts, as no one can join after that. 
+	void CancelOpenReservations();
+
+	// Drops expired reservations and updates the advertised AcceptingPlayers. Runs on a timer while there are reservations. 
+	void UpdateReservations();
 
 	virtual bool ProcessAutoLogin() override;
 
+	// Lets clients holding a reservation in until the match starts and turns everyone else away if the free slots are all reserved. 
+	virtual FString ApproveLogin(const FString& Options) override;
+
 	virtual void RegisterPlayer(APlayerController* NewPlayer, const FUniqueNetIdRepl& UniqueId, bool bWasFromInvite) override;
 
 	virtual void UnregisterPlayer(const APlayerController* ExitingPlayer) override;
@@ -64,8 +239,21 @@ private:
 
 	void HandleCreateSessionCompleted(FName EOSSessionName, bool bWasSuccessful);
 
+	void HandleUpdateSessionCompleted(FName EOSSessionName, bool bWasSuccessful);
+
+	// Unique id of a player, from its PlayerState or, if it left before having one, from its connection. 
+	static FUniqueNetIdRepl GetPlayerUniqueId(const APlayerController* PC);
+
+	void SampleNetTelemetry();
+
+	// Stops sampling and logs the telemetry summary. 
+	void FinishNetTelemetry();
+
 	void HandleRegisterPlayerCompleted(FName EOSSessionName, const TArray<FUniqueNetIdRef>& PlayerIds, bool bWasSuccesful);
 	
+	// Asks the scheduler whether the match should start and starts the session if so. Runs on a timer while players are queued.
+	void EvaluateMatchStart();
+
 	void StartSession();
 
 	// Callback function. This function will run when start session compeletes.
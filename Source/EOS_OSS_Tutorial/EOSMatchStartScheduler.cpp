@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EOSMatchStartScheduler.h"
+
+void FEOSMatchStartScheduler::Configure(const FEOSMatchStartSettings& InSettings)
+{
+	Settings = InSettings;
+	Settings.Capacity = FMath::Max(Settings.Capacity, 1);
+	Settings.MinPlayers = FMath::Clamp(Settings.MinPlayers, 1, Settings.Capacity);
+	Settings.MinCountdown = FMath::Max(Settings.MinCountdown, 0.f);
+	Settings.MaxCountdown = FMath::Max(Settings.MaxCountdown, Settings.MinCountdown);
+}
+
+void FEOSMatchStartScheduler::AddPlayer(const FString& PlayerId, double Now)
+{
+	if (QueuedSince.Contains(PlayerId))
+	{
+		return;
+	}
+
+	QueuedSince.Add(PlayerId, Now);
+	if (FirstQueuedAt < 0.0)
+	{
+		FirstQueuedAt = Now;
+	}
+
+	UpdateCountdown(Now);
+}
+
+void FEOSMatchStartScheduler::RemovePlayer(const FString& PlayerId, double Now)
+{
+	if (QueuedSince.Remove(PlayerId) == 0)
+	{
+		return;
+	}
+
+	// Nobody left waiting, the hard timeout starts over with the next player
+	if (QueuedSince.Num() == 0)
+	{
+		FirstQueuedAt = -1.0;
+	}
+
+	UpdateCountdown(Now);
+}
+
+bool FEOSMatchStartScheduler::ShouldStart(double Now) const
+{
+	const int32 NumQueued = QueuedSince.Num();
+	if (NumQueued == 0)
+	{
+		return false;
+	}
+
+	const bool bFull = NumQueued >= Settings.Capacity;
+	const bool bCountdownDone = CountdownEndsAt >= 0.0 && Now >= CountdownEndsAt;
+	const bool bTimedOut = Settings.HardTimeout > 0.f && Now >= FirstQueuedAt + Settings.HardTimeout;
+
+	return bFull || bCountdownDone || bTimedOut;
+}
+
+double FEOSMatchStartScheduler::GetRemainingCountdown(double Now) const
+{
+	return CountdownEndsAt >= 0.0 ? FMath::Max(CountdownEndsAt - Now, 0.0) : -1.0;
+}
+
+void FEOSMatchStartScheduler::LogQueueWaitTimes(double StartTime) const
+{
+	if (QueuedSince.Num() == 0)
+	{
+		return;
+	}
+
+	double TotalWait = 0.0;
+	double LongestWait = 0.0;
+	for (const TPair<FString, double>& Pair : QueuedSince)
+	{
+		const double Wait = StartTime - Pair.Value;
+		TotalWait += Wait;
+		LongestWait = FMath::Max(LongestWait, Wait);
+		UE_LOG(LogTemp, Log, TEXT("  %s waited %.1f s for the match to start."), *Pair.Key, Wait);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Match starting with %d/%d players, queue wait avg %.1f s, max %.1f s."),
+		QueuedSince.Num(), Settings.Capacity, TotalWait / QueuedSince.Num(), LongestWait);
+}
+
+void FEOSMatchStartScheduler::Reset()
+{
+	QueuedSince.Reset();
+	FirstQueuedAt = -1.0;
+	CountdownEndsAt = -1.0;
+}
+
+void FEOSMatchStartScheduler::UpdateCountdown(double Now)
+{
+	const int32 NumQueued = QueuedSince.Num();
+	if (NumQueued < Settings.MinPlayers)
+	{
+		CountdownEndsAt = -1.0;
+		return;
+	}
+
+	// The fuller the server, the shorter the countdown
+	const float FillAlpha = Settings.Capacity > Settings.MinPlayers
+		? static_cast<float>(NumQueued - Settings.MinPlayers) / (Settings.Capacity - Settings.MinPlayers)
+		: 1.f;
+	const double Countdown = FMath::Lerp(Settings.MaxCountdown, Settings.MinCountdown, FMath::Clamp(FillAlpha, 0.f, 1.f));
+	const double NewEndsAt = Now + Countdown;
+
+	// A running countdown only ever gets shorter, players already waiting shouldn't be pushed back by someone joining
+	CountdownEndsAt = CountdownEndsAt >= 0.0 ? FMath::Min(CountdownEndsAt, NewEndsAt) : NewEndsAt;
+}
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Settings for FEOSMatchStartScheduler. Times are in seconds, a timeout of 0 or less disables it.
+ */
+struct FEOSMatchStartSettings
+{
+	int32 Capacity = 2;
+
+	int32 MinPlayers = 1;
+
+	// Countdown once MinPlayers are in. It shortens linearly towards MinCountdown as the server fills up. 
+	float MaxCountdown = 30.f;
+
+	float MinCountdown = 5.f;
+
+	// The match starts this long after the first player queued, with whoever is there. 
+	float HardTimeout = 120.f;
+};
+
+/**
+ * Decides when the dedicated server starts its session. The match starts as soon as the server is full, when the countdown that
+ * runs while at least MinPlayers are queued runs out, or when the hard timeout since the first player queued expires.
+ */
+class FEOSMatchStartScheduler
+{
+public:
+
+	void Configure(const FEOSMatchStartSettings& InSettings);
+
+	const FEOSMatchStartSettings& GetSettings() const { return Settings; }
+
+	void AddPlayer(const FString& PlayerId, double Now);
+
+	void RemovePlayer(const FString& PlayerId, double Now);
+
+	// Returns true if the match should start at Now. 
+	bool ShouldStart(double Now) const;
+
+	// Seconds until the countdown runs out, or a negative value if no countdown is running. 
+	double GetRemainingCountdown(double Now) const;
+
+	int32 GetNumQueuedPlayers() const { return QueuedSince.Num(); }
+
+	// Logs how long every queued player waited for the match to start. 
+	void LogQueueWaitTimes(double StartTime) const;
+
+	void Reset();
+
+private:
+
+	// Recomputes the countdown after a player joined or left. 
+	void UpdateCountdown(double Now);
+
+	FEOSMatchStartSettings Settings;
+
+	// When each queued player was registered. 
+	TMap<FString, double> QueuedSince;
+
+	double FirstQueuedAt = -1.0;
+
+	// When the running countdown ends, negative while no countdown is running. 
+	double CountdownEndsAt = -1.0;
+};
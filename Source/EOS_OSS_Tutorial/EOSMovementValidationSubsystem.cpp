@@ -0,0 +1,257 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EOSMovementValidationSubsystem.h"
+
+#include "EOS_OSS_TutorialCharacter.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+bool UEOSMovementValidationSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Clients have nothing to validate, only the dedicated server is authoritative over movement
+	return IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+TStatId UEOSMovementValidationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEOSMovementValidationSubsystem, STATGROUP_Tickables);
+}
+
+void UEOSMovementValidationSubsystem::RegisterCharacter(AEOS_OSS_TutorialCharacter* Character)
+{
+	if (!Character || Characters.Contains(Character))
+	{
+		return;
+	}
+
+	Characters.Add(Character);
+	PrevLocationX.Add(0.f);
+	PrevLocationY.Add(0.f);
+	PrevLocationZ.Add(0.f);
+	PrevVelocityX.Add(0.f);
+	PrevVelocityY.Add(0.f);
+	PrevClientTimeStamp.Add(0.f);
+	ClientTimeCredit.Add(0.f);
+	HasPrevious.Add(0);
+	IsExempt.Add(0);
+	ViolationCounts.Add(0);
+}
+
+void UEOSMovementValidationSubsystem::UnregisterCharacter(AEOS_OSS_TutorialCharacter* Character)
+{
+	const int32 Index = Characters.IndexOfByKey(Character);
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Swap remove on every array so the per-character entries stay lined up
+	Characters.RemoveAtSwap(Index);
+	PrevLocationX.RemoveAtSwap(Index);
+	PrevLocationY.RemoveAtSwap(Index);
+	PrevLocationZ.RemoveAtSwap(Index);
+	PrevVelocityX.RemoveAtSwap(Index);
+	PrevVelocityY.RemoveAtSwap(Index);
+	PrevClientTimeStamp.RemoveAtSwap(Index);
+	ClientTimeCredit.RemoveAtSwap(Index);
+	HasPrevious.RemoveAtSwap(Index);
+	IsExempt.RemoveAtSwap(Index);
+	ViolationCounts.RemoveAtSwap(Index);
+}
+
+void UEOSMovementValidationSubsystem::ExemptUntilGrounded(AEOS_OSS_TutorialCharacter* Character)
+{
+	const int32 Index = Characters.IndexOfByKey(Character);
+	if (Index != INDEX_NONE)
+	{
+		IsExempt[Index] = 1;
+	}
+}
+
+void UEOSMovementValidationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Characters.Num() == 0 || DeltaTime <= 0.f)
+	{
+		return;
+	}
+
+	GatherMoves();
+	ValidateMoves(DeltaTime);
+	ResolveViolations();
+}
+
+void UEOSMovementValidationSubsystem::GatherMoves()
+{
+	const int32 NumCharacters = Characters.Num();
+
+	LocationX.SetNumUninitialized(NumCharacters);
+	LocationY.SetNumUninitialized(NumCharacters);
+	LocationZ.SetNumUninitialized(NumCharacters);
+	VelocityX.SetNumUninitialized(NumCharacters);
+	VelocityY.SetNumUninitialized(NumCharacters);
+	VelocityZ.SetNumUninitialized(NumCharacters);
+	ClientTimeStamp.SetNumUninitialized(NumCharacters);
+	MaxSpeed.SetNumUninitialized(NumCharacters);
+	MaxJumpZVelocity.SetNumUninitialized(NumCharacters);
+	MaxAcceleration.SetNumUninitialized(NumCharacters);
+	IsActive.SetNumUninitialized(NumCharacters);
+	Violations.SetNumUninitialized(NumCharacters);
+
+	for (int32 Index = 0; Index < NumCharacters; ++Index)
+	{
+		const AEOS_OSS_TutorialCharacter* Character = Characters[Index].Get();
+		const UCharacterMovementComponent* Movement = Character ? Character->GetCharacterMovement() : nullptr;
+
+		// Only moves sent by players need validating. Dormant (e.g. pooled) characters have their movement deactivated.
+		const bool bActive = Movement && Movement->IsActive() && Character->IsPlayerControlled();
+		IsActive[Index] = bActive ? 1 : 0;
+		Violations[Index] = EViolation::None;
+
+		if (!bActive)
+		{
+			LocationX[Index] = LocationY[Index] = LocationZ[Index] = 0.f;
+			VelocityX[Index] = VelocityY[Index] = VelocityZ[Index] = 0.f;
+			ClientTimeStamp[Index] = 0.f;
+			MaxSpeed[Index] = MaxJumpZVelocity[Index] = MaxAcceleration[Index] = 0.f;
+			continue;
+		}
+
+		const FVector Location = Character->GetActorLocation();
+		LocationX[Index] = static_cast<float>(Location.X);
+		LocationY[Index] = static_cast<float>(Location.Y);
+		LocationZ[Index] = static_cast<float>(Location.Z);
+
+		VelocityX[Index] = static_cast<float>(Movement->Velocity.X);
+		VelocityY[Index] = static_cast<float>(Movement->Velocity.Y);
+		VelocityZ[Index] = static_cast<float>(Movement->Velocity.Z);
+
+		// Time stamp of the last move the client sent, the moves received since last tick cover the client time in between
+		const FNetworkPredictionData_Server_Character* ServerData = Movement->HasPredictionData_Server() ? Movement->GetPredictionData_Server_Character() : nullptr;
+		ClientTimeStamp[Index] = ServerData ? ServerData->CurrentClientTimeStamp : 0.f;
+
+		// Moving bases carry the character along and impart their velocity when it jumps off, launches add any velocity they like.
+		// Neither is bound by the walking limits, so skip the checks until the character has landed on static ground again.
+		const bool bOnMovingBase = MovementBaseUtility::IsDynamicBase(Movement->GetMovementBase());
+		if (bOnMovingBase || !Movement->PendingLaunchVelocity.IsZero())
+		{
+			IsExempt[Index] = 1;
+		}
+		else if (Movement->IsMovingOnGround())
+		{
+			IsExempt[Index] = 0;
+		}
+
+		MaxSpeed[Index] = Movement->GetMaxSpeed();
+		MaxJumpZVelocity[Index] = Movement->JumpZVelocity;
+
+		// Friction can change velocity a lot faster than MaxAcceleration when stopping or turning, so allow for it
+		const float FrictionDeceleration = Movement->GroundFriction * FMath::Max(Movement->BrakingFrictionFactor, 2.f) * MaxSpeed[Index];
+		MaxAcceleration[Index] = Movement->GetMaxAcceleration() + Movement->BrakingDecelerationWalking + FrictionDeceleration;
+	}
+}
+
+void UEOSMovementValidationSubsystem::ValidateMoves(float DeltaTime)
+{
+	const int32 NumCharacters = Characters.Num();
+
+	for (int32 Index = 0; Index < NumCharacters; ++Index)
+	{
+		// Moves arrive bunched, so one server frame can cover several frames of client time. The time stamps come from the
+		// client though, so only credit as much client time as the server has seen pass (plus ClientTimeSlack). A time stamp
+		// reset or no moves at all gives a delta of zero or less, fall back to the server frame then.
+		ClientTimeCredit[Index] = FMath::Min(ClientTimeCredit[Index] + DeltaTime, MaxClientTimeCredit);
+		const float ClientDeltaTime = HasPrevious[Index] * FMath::Clamp(ClientTimeStamp[Index] - PrevClientTimeStamp[Index], 0.f, ClientTimeCredit[Index] + ClientTimeSlack);
+		ClientTimeCredit[Index] -= ClientDeltaTime;
+		const float ElapsedTime = FMath::Max(ClientDeltaTime, DeltaTime);
+		const float InvElapsedTime = 1.f / ElapsedTime;
+
+		const float SpeedLimit = MaxSpeed[Index] * SpeedTolerance;
+		const float HorizontalSpeedSquared = VelocityX[Index] * VelocityX[Index] + VelocityY[Index] * VelocityY[Index];
+
+		const float JumpLimit = MaxJumpZVelocity[Index] * SpeedTolerance;
+
+		// Only horizontal, landing legitimately zeroes a large vertical velocity in one tick
+		const float DeltaVelocityX = VelocityX[Index] - PrevVelocityX[Index];
+		const float DeltaVelocityY = VelocityY[Index] - PrevVelocityY[Index];
+		const float AccelerationSquared = (DeltaVelocityX * DeltaVelocityX + DeltaVelocityY * DeltaVelocityY) * InvElapsedTime * InvElapsedTime;
+		const float AccelerationLimit = MaxAcceleration[Index] * AccelerationTolerance;
+
+		// Only horizontal, falling is not limited by MaxSpeed
+		const float DeltaX = LocationX[Index] - PrevLocationX[Index];
+		const float DeltaY = LocationY[Index] - PrevLocationY[Index];
+		const float DistanceSquared = DeltaX * DeltaX + DeltaY * DeltaY;
+		const float DistanceLimit = SpeedLimit * ElapsedTime + TeleportSlack;
+
+		const uint8 bHasPrevious = HasPrevious[Index] & IsActive[Index];
+
+		Violations[Index] = static_cast<uint8>(IsActive[Index] * (1 - IsExempt[Index]) * (
+			(HorizontalSpeedSquared > SpeedLimit * SpeedLimit ? EViolation::Speed : EViolation::None) |
+			(VelocityZ[Index] > JumpLimit ? EViolation::JumpVelocity : EViolation::None) |
+			bHasPrevious * (AccelerationSquared > AccelerationLimit * AccelerationLimit ? EViolation::Acceleration : EViolation::None) |
+			bHasPrevious * (DistanceSquared > DistanceLimit * DistanceLimit ? EViolation::Teleport : EViolation::None)));
+	}
+}
+
+void UEOSMovementValidationSubsystem::ResolveViolations()
+{
+	const int32 NumCharacters = Characters.Num();
+
+	for (int32 Index = 0; Index < NumCharacters; ++Index)
+	{
+		if (!IsActive[Index])
+		{
+			// Start over once the character becomes active again, e.g. after being handed out by the pawn pool
+			HasPrevious[Index] = 0;
+			ClientTimeCredit[Index] = 0.f;
+			continue;
+		}
+
+		if (Violations[Index] != EViolation::None)
+		{
+			AEOS_OSS_TutorialCharacter* Character = Characters[Index].Get();
+			UCharacterMovementComponent* Movement = Character->GetCharacterMovement();
+
+			ViolationCounts[Index]++;
+			UE_LOG(LogTemp, Warning, TEXT("Movement violation by %s (flags 0x%x, %d so far): speed %.0f/%.0f, vertical %.0f/%.0f"),
+				*Character->GetName(), Violations[Index], ViolationCounts[Index],
+				FMath::Sqrt(VelocityX[Index] * VelocityX[Index] + VelocityY[Index] * VelocityY[Index]), MaxSpeed[Index],
+				VelocityZ[Index], MaxJumpZVelocity[Index]);
+
+			if (bCorrectViolations)
+			{
+				if (Violations[Index] & EViolation::Teleport)
+				{
+					// Put the character back where it was last tick
+					Character->SetActorLocation(FVector(PrevLocationX[Index], PrevLocationY[Index], PrevLocationZ[Index]), false, nullptr, ETeleportType::TeleportPhysics);
+					Movement->Velocity = FVector(PrevVelocityX[Index], PrevVelocityY[Index], 0.f);
+				}
+				else if (Violations[Index] & (EViolation::Speed | EViolation::JumpVelocity))
+				{
+					FVector ClampedVelocity = Movement->Velocity.GetClampedToMaxSize2D(MaxSpeed[Index]);
+					ClampedVelocity.Z = FMath::Min(ClampedVelocity.Z, MaxJumpZVelocity[Index]);
+					Movement->Velocity = ClampedVelocity;
+				}
+
+				// Make sure the owning client gets the corrected state
+				Movement->ForceClientAdjustment();
+
+				const FVector CorrectedLocation = Character->GetActorLocation();
+				LocationX[Index] = static_cast<float>(CorrectedLocation.X);
+				LocationY[Index] = static_cast<float>(CorrectedLocation.Y);
+				LocationZ[Index] = static_cast<float>(CorrectedLocation.Z);
+				VelocityX[Index] = static_cast<float>(Movement->Velocity.X);
+				VelocityY[Index] = static_cast<float>(Movement->Velocity.Y);
+			}
+		}
+
+		PrevLocationX[Index] = LocationX[Index];
+		PrevLocationY[Index] = LocationY[Index];
+		PrevLocationZ[Index] = LocationZ[Index];
+		PrevVelocityX[Index] = VelocityX[Index];
+		PrevVelocityY[Index] = VelocityY[Index];
+		PrevClientTimeStamp[Index] = ClientTimeStamp[Index];
+		HasPrevious[Index] = 1;
+	}
+}
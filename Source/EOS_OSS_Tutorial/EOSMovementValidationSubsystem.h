@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EOSMovementValidationSubsystem.generated.h"
+
+class AEOS_OSS_TutorialCharacter;
+
+/**
+ * Server-side movement validation for every player character, done in one pass per tick instead of per actor.
+ * Each tick the latest location/velocity of every character is gathered into structure-of-arrays buffers, checked
+ * against its movement component's speed, jump and acceleration limits and against teleporting, and violators are
+ * flagged and (optionally) corrected. Distances and velocity changes are measured against the client time covered by
+ * the moves the server received, not the server frame time, as moves often arrive bunched together.
+ */
+UCLASS(config=Game)
+class EOS_OSS_TUTORIAL_API UEOSMovementValidationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+
+	// Multiplier on the movement component limits before a move counts as a violation. Leaves room for network jitter. 
+	UPROPERTY(config)
+	float SpeedTolerance = 1.25f;
+
+	UPROPERTY(config)
+	float AccelerationTolerance = 1.5f;
+
+	// Extra distance (cm) a character may cover in one tick on top of its max speed before it counts as a teleport. 
+	UPROPERTY(config)
+	float TeleportSlack = 50.f;
+
+	// How far (s) a client's move time stamps may run ahead of the server's clock. Beyond that the client time is not credited,
+	// a speed hack that runs the time stamps fast can't stretch the distance limit. 
+	UPROPERTY(config)
+	float ClientTimeSlack = 0.1f;
+
+	// Longest stall (s) after which bunched-up moves are still credited in full. 
+	UPROPERTY(config)
+	float MaxClientTimeCredit = 1.f;
+
+	// If false violations are only logged. Off by default, turn it on once the tolerances are tuned for the game. 
+	UPROPERTY(config)
+	bool bCorrectViolations = false;
+
+	TArray<TWeakObjectPtr<AEOS_OSS_TutorialCharacter>> Characters;
+
+	// State from the previous tick, one entry per character. 
+	TArray<float> PrevLocationX, PrevLocationY, PrevLocationZ;
+	TArray<float> PrevVelocityX, PrevVelocityY;
+	TArray<float> PrevClientTimeStamp;
+
+	// Server time passed minus client time credited, per character. Goes down to -ClientTimeSlack at most. 
+	TArray<float> ClientTimeCredit;
+	TArray<uint8> HasPrevious;
+
+	// Set while a character may legitimately exceed its walking limits: launched, or on/leaving a moving base. Cleared on landing. 
+	TArray<uint8> IsExempt;
+
+	// Scratch buffers filled during the gather, reused every tick. 
+	TArray<float> LocationX, LocationY, LocationZ;
+	TArray<float> VelocityX, VelocityY, VelocityZ;
+	TArray<float> ClientTimeStamp;
+	TArray<float> MaxSpeed, MaxJumpZVelocity, MaxAcceleration;
+	TArray<uint8> IsActive;
+	TArray<uint8> Violations;
+
+	// Number of violations per character, for logging. 
+	TArray<int32> ViolationCounts;
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	void RegisterCharacter(AEOS_OSS_TutorialCharacter* Character);
+
+	void UnregisterCharacter(AEOS_OSS_TutorialCharacter* Character);
+
+	// Skips the checks for this character until it is back on (static) ground, e.g. after LaunchCharacter. 
+	void ExemptUntilGrounded(AEOS_OSS_TutorialCharacter* Character);
+
+private:
+
+	enum EViolation : uint8
+	{
+		None = 0,
+		Speed = 1 << 0,
+		JumpVelocity = 1 << 1,
+		Acceleration = 1 << 2,
+		Teleport = 1 << 3
+	};
+
+	// Copies the latest move of every character into the scratch buffers. 
+	void GatherMoves();
+
+	// Checks every gathered move against its limits. Only touches the buffers, so it's a single tight loop. 
+	void ValidateMoves(float DeltaTime);
+
+	// Logs and corrects the characters flagged in ValidateMoves, and stores this tick's state for the next one. 
+	void ResolveViolations();
+};
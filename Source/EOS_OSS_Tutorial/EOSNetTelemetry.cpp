@@ -0,0 +1,160 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EOSNetTelemetry.h"
+
+#include "Engine/NetConnection.h"
+#include "GameFramework/PlayerController.h"
+
+void FEOSNetTelemetry::AddConnection(const FUniqueNetIdRepl& UniqueId, const APlayerController* PlayerController)
+{
+	if (!UniqueId.IsValid() || !PlayerController)
+	{
+		return;
+	}
+
+	UNetConnection* Connection = PlayerController->GetNetConnection();
+	if (!Connection)
+	{
+		return;
+	}
+
+	// A player that reconnects keeps their stats from earlier in the session. 
+	FConnectionStats& Stats = Connections.FindOrAdd(UniqueId);
+	Stats.PlayerController = PlayerController;
+	Stats.RemoteAddress = Connection->LowLevelGetRemoteAddress(true);
+
+	// Go by the address, not the driver class. NetDriverEOS passes plain IP connections through, which is all a dedicated server
+	// gets as it has no ProductUserId to do P2P with. Only connections over EOS P2P sockets have EOS: addresses.
+	if (Stats.RemoteAddress.StartsWith(TEXT("EOS:")))
+	{
+		Stats.Transport = EEOSConnectionTransport::EOSP2P;
+	}
+	else if (!Stats.RemoteAddress.IsEmpty())
+	{
+		Stats.Transport = EEOSConnectionTransport::IP;
+	}
+	else
+	{
+		Stats.Transport = EEOSConnectionTransport::Unknown;
+	}
+}
+
+void FEOSNetTelemetry::Sample()
+{
+	for (TPair<FUniqueNetIdRepl, FConnectionStats>& Pair : Connections)
+	{
+		FConnectionStats& Stats = Pair.Value;
+
+		const APlayerController* PlayerController = Stats.PlayerController.Get();
+		UNetConnection* Connection = PlayerController ? PlayerController->GetNetConnection() : nullptr;
+		if (!Connection || Connection->GetConnectionState() != USOCK_Open)
+		{
+			continue; // Player left, keep the stats for the summary
+		}
+
+		FEOSConnectionSample Sample;
+		Sample.RTTMs = static_cast<float>(Connection->AvgLag * 1000.0);
+		Sample.JitterMs = Connection->GetAverageJitterInMS();
+		Sample.InLossPercent = Connection->GetInLossPercentage().GetAvgLossPercentage() * 100.f;
+		Sample.OutLossPercent = Connection->GetOutLossPercentage().GetAvgLossPercentage() * 100.f;
+		Sample.InBytesPerSecond = Connection->InBytesPerSecond;
+		Sample.OutBytesPerSecond = Connection->OutBytesPerSecond;
+
+		Stats.AddSample(Sample);
+	}
+}
+
+void FEOSNetTelemetry::LogSummary() const
+{
+	UE_LOG(LogTemp, Log, TEXT("Network telemetry for %d connection(s):"), Connections.Num());
+
+	for (const TPair<FUniqueNetIdRepl, FConnectionStats>& Pair : Connections)
+	{
+		const FConnectionStats& Stats = Pair.Value;
+		if (Stats.TotalSamples == 0)
+		{
+			UE_LOG(LogTemp, Log, TEXT("  %s (%s, %s): no samples"), *Pair.Key.ToString(), LexToString(Stats.Transport), *Stats.RemoteAddress);
+			continue;
+		}
+
+		const FEOSConnectionSample RecentAverage = Stats.GetRecentAverage();
+
+		UE_LOG(LogTemp, Log, TEXT("  %s (%s, %s): %lld s sampled, RTT avg %.1f / min %.1f / max %.1f ms, jitter avg %.1f / max %.1f ms, loss in %.2f%% / out %.2f%%, ~%lld bytes in / ~%lld bytes out (estimated from rates)"),
+			*Pair.Key.ToString(), LexToString(Stats.Transport), *Stats.RemoteAddress, Stats.TotalSamples,
+			Stats.SumRTTMs / Stats.TotalSamples, Stats.MinRTTMs, Stats.MaxRTTMs,
+			Stats.SumJitterMs / Stats.TotalSamples, Stats.MaxJitterMs,
+			Stats.SumInLossPercent / Stats.TotalSamples, Stats.SumOutLossPercent / Stats.TotalSamples,
+			Stats.EstimatedTotalInBytes, Stats.EstimatedTotalOutBytes);
+
+		UE_LOG(LogTemp, Log, TEXT("    last %d s: RTT avg %.1f ms, jitter %.1f ms, loss in %.2f%% / out %.2f%%, %d B/s in / %d B/s out"),
+			Stats.NumRecentSamples, RecentAverage.RTTMs, RecentAverage.JitterMs, RecentAverage.InLossPercent, RecentAverage.OutLossPercent,
+			RecentAverage.InBytesPerSecond, RecentAverage.OutBytesPerSecond);
+	}
+}
+
+void FEOSNetTelemetry::Reset()
+{
+	Connections.Reset();
+}
+
+void FEOSNetTelemetry::FConnectionStats::AddSample(const FEOSConnectionSample& Sample)
+{
+	RecentSamples[NextSampleIndex] = Sample;
+	NextSampleIndex = (NextSampleIndex + 1) % SampleWindow;
+	NumRecentSamples = FMath::Min(NumRecentSamples + 1, SampleWindow);
+
+	TotalSamples++;
+	SumRTTMs += Sample.RTTMs;
+	MinRTTMs = FMath::Min(MinRTTMs, Sample.RTTMs);
+	MaxRTTMs = FMath::Max(MaxRTTMs, Sample.RTTMs);
+	SumJitterMs += Sample.JitterMs;
+	MaxJitterMs = FMath::Max(MaxJitterMs, Sample.JitterMs);
+	SumInLossPercent += Sample.InLossPercent;
+	SumOutLossPercent += Sample.OutLossPercent;
+	EstimatedTotalInBytes += Sample.InBytesPerSecond;
+	EstimatedTotalOutBytes += Sample.OutBytesPerSecond;
+}
+
+FEOSConnectionSample FEOSNetTelemetry::FConnectionStats::GetRecentAverage() const
+{
+	FEOSConnectionSample Average;
+	if (NumRecentSamples == 0)
+	{
+		return Average;
+	}
+
+	int64 SumInBytes = 0;
+	int64 SumOutBytes = 0;
+	for (int32 Index = 0; Index < NumRecentSamples; ++Index)
+	{
+		const FEOSConnectionSample& Sample = RecentSamples[Index];
+		Average.RTTMs += Sample.RTTMs;
+		Average.JitterMs += Sample.JitterMs;
+		Average.InLossPercent += Sample.InLossPercent;
+		Average.OutLossPercent += Sample.OutLossPercent;
+		SumInBytes += Sample.InBytesPerSecond;
+		SumOutBytes += Sample.OutBytesPerSecond;
+	}
+
+	Average.RTTMs /= NumRecentSamples;
+	Average.JitterMs /= NumRecentSamples;
+	Average.InLossPercent /= NumRecentSamples;
+	Average.OutLossPercent /= NumRecentSamples;
+	Average.InBytesPerSecond = static_cast<int32>(SumInBytes / NumRecentSamples);
+	Average.OutBytesPerSecond = static_cast<int32>(SumOutBytes / NumRecentSamples);
+	return Average;
+}
+
+const TCHAR* FEOSNetTelemetry::LexToString(EEOSConnectionTransport Transport)
+{
+	switch (Transport)
+	{
+	case EEOSConnectionTransport::EOSP2P:
+		return TEXT("EOS P2P");
+	case EEOSConnectionTransport::IP:
+		return TEXT("IP");
+	default:
+		return TEXT("Unknown");
+	}
+}
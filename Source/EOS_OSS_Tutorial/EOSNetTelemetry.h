@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "GameFramework/OnlineReplStructs.h"
+
+class APlayerController;
+
+/**
+ * What a connection actually runs over, from its remote address. EOS P2P connections (EOS: addresses) may be direct or relayed,
+ * the OSS doesn't tell us which. Everything else is plain IP, including NetDriverEOS running as IP passthrough on a dedicated server.
+ */
+enum class EEOSConnectionTransport : uint8
+{
+	Unknown,
+	EOSP2P,
+	IP
+};
+
+/**
+ * One per-second sample of a connection.
+ */
+struct FEOSConnectionSample
+{
+	float RTTMs = 0.f;
+
+	// The connection's own smoothed jitter, measured from the timestamps of individual packets. 
+	float JitterMs = 0.f;
+
+	// Packet loss in percent (0-100). 
+	float InLossPercent = 0.f;
+	float OutLossPercent = 0.f;
+
+	// Rates over the connection's last stat period. 
+	int32 InBytesPerSecond = 0;
+	int32 OutBytesPerSecond = 0;
+};
+
+/**
+ * Per-connection network telemetry for the dedicated server, keyed by the player's unique id. Each connection keeps its most recent
+ * samples in a fixed-size ring buffer plus running totals for the whole session, so memory doesn't grow with session length.
+ */
+class FEOSNetTelemetry
+{
+public:
+
+	// Number of samples kept per connection. At one sample per second this is the last minute. 
+	static constexpr int32 SampleWindow = 60;
+
+	// Starts tracking the connection of a player that registered in the session. 
+	void AddConnection(const FUniqueNetIdRepl& UniqueId, const APlayerController* PlayerController);
+
+	// Takes one sample of every tracked connection that is still open. 
+	void Sample();
+
+	// Logs the per-player summary for the session. 
+	void LogSummary() const;
+
+	void Reset();
+
+	bool IsEmpty() const { return Connections.Num() == 0; }
+
+private:
+
+	struct FConnectionStats
+	{
+		TWeakObjectPtr<const APlayerController> PlayerController;
+
+		EEOSConnectionTransport Transport = EEOSConnectionTransport::Unknown;
+
+		FString RemoteAddress;
+
+		// Ring buffer of the most recent samples. 
+		TStaticArray<FEOSConnectionSample, SampleWindow> RecentSamples;
+		int32 NextSampleIndex = 0;
+		int32 NumRecentSamples = 0;
+
+		// Running totals over the whole session. 
+		int64 TotalSamples = 0;
+		double SumRTTMs = 0.0;
+		float MinRTTMs = TNumericLimits<float>::Max();
+		float MaxRTTMs = 0.f;
+		double SumJitterMs = 0.0;
+		float MaxJitterMs = 0.f;
+		double SumInLossPercent = 0.0;
+		double SumOutLossPercent = 0.0;
+		// Sum of the sampled per-second rates, so only an estimate of the bytes actually sent. 
+		int64 EstimatedTotalInBytes = 0;
+		int64 EstimatedTotalOutBytes = 0;
+
+		void AddSample(const FEOSConnectionSample& Sample);
+
+		FEOSConnectionSample GetRecentAverage() const;
+	};
+
+	TMap<FUniqueNetIdRepl, FConnectionStats> Connections;
+
+	static const TCHAR* LexToString(EEOSConnectionTransport Transport);
+};
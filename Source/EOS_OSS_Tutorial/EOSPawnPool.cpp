@@ -0,0 +1,132 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EOSPawnPool.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+
+void UEOSPawnPool::Fill(UWorld* World, TSubclassOf<APawn> InPawnClass, int32 PoolSize)
+{
+	if (!World || !InPawnClass || PoolSize <= 0)
+	{
+		return;
+	}
+
+	PawnClass = InPawnClass;
+
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnInfo.ObjectFlags |= RF_Transient; // Never save pooled pawns into a map package, same as the default pawn spawn
+
+	double TotalSpawnSeconds = 0.0;
+	int32 NumSpawned = 0;
+
+	for (int32 Index = 0; Index < PoolSize; ++Index)
+	{
+		const double SpawnStartTime = FPlatformTime::Seconds();
+		APawn* Pawn = World->SpawnActor<APawn>(PawnClass, FTransform::Identity, SpawnInfo);
+		TotalSpawnSeconds += FPlatformTime::Seconds() - SpawnStartTime;
+
+		if (!Pawn)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to spawn pawn for the pawn pool!"));
+			continue;
+		}
+
+		SetPawnDormant(Pawn, true);
+		PooledPawns.Add(Pawn);
+		DormantPawns.Add(Pawn);
+		NumSpawned++;
+	}
+
+	AverageSpawnSeconds = NumSpawned > 0 ? TotalSpawnSeconds / NumSpawned : 0.0;
+
+	UE_LOG(LogTemp, Log, TEXT("Pawn pool filled with %d %s (%.2f ms per spawn)."), NumSpawned, *GetNameSafe(PawnClass), AverageSpawnSeconds * 1000.0);
+}
+
+APawn* UEOSPawnPool::Acquire(TSubclassOf<APawn> RequestedClass, const FTransform& SpawnTransform)
+{
+	if (!PawnClass || RequestedClass != PawnClass)
+	{
+		return nullptr;
+	}
+
+	const double AcquireStartTime = FPlatformTime::Seconds();
+
+	APawn* Pawn = nullptr;
+	while (!IsValid(Pawn) && DormantPawns.Num() > 0)
+	{
+		Pawn = DormantPawns.Pop(EAllowShrinking::No);
+	}
+
+	if (!IsValid(Pawn))
+	{
+		NumPoolMisses++;
+		UE_LOG(LogTemp, Warning, TEXT("Pawn pool is empty, falling back to spawning a new pawn."));
+		return nullptr;
+	}
+
+	Pawn->SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.Rotator(), false, nullptr, ETeleportType::ResetPhysics);
+	SetPawnDormant(Pawn, false);
+
+	const double SavedSeconds = FMath::Max(0.0, AverageSpawnSeconds - (FPlatformTime::Seconds() - AcquireStartTime));
+	TotalSavedSeconds += SavedSeconds;
+	NumPooledHandOuts++;
+
+	UE_LOG(LogTemp, Log, TEXT("Handed out pooled pawn %s, saved %.2f ms of spawn time (%d left in pool)."), *Pawn->GetName(), SavedSeconds * 1000.0, DormantPawns.Num());
+
+	return Pawn;
+}
+
+bool UEOSPawnPool::Release(APawn* Pawn)
+{
+	if (!IsValid(Pawn) || !Owns(Pawn) || DormantPawns.Contains(Pawn))
+	{
+		return false;
+	}
+
+	SetPawnDormant(Pawn, true);
+	DormantPawns.Add(Pawn);
+
+	UE_LOG(LogTemp, Log, TEXT("Returned pawn %s to the pool (%d in pool)."), *Pawn->GetName(), DormantPawns.Num());
+	return true;
+}
+
+bool UEOSPawnPool::Owns(const APawn* Pawn) const
+{
+	return Pawn && PooledPawns.Contains(Pawn);
+}
+
+void UEOSPawnPool::LogSummary() const
+{
+	UE_LOG(LogTemp, Log, TEXT("Pawn pool summary: %d pooled hand outs, %d misses, %.2f ms of spawn hitches saved."),
+		NumPooledHandOuts, NumPoolMisses, TotalSavedSeconds * 1000.0);
+}
+
+void UEOSPawnPool::SetPawnDormant(APawn* Pawn, bool bDormant)
+{
+	// A hidden actor without collision isn't net relevant, so dormant pawns are not replicated to anyone. 
+	Pawn->SetActorHiddenInGame(bDormant);
+	Pawn->SetActorEnableCollision(!bDormant);
+	Pawn->SetActorTickEnabled(!bDormant);
+
+	if (ACharacter* Character = Cast<ACharacter>(Pawn))
+	{
+		UCharacterMovementComponent* Movement = Character->GetCharacterMovement();
+		Movement->StopMovementImmediately();
+		if (bDormant)
+		{
+			// Deactivating the movement component stops its tick, so a dormant pawn doesn't fall or simulate. 
+			Movement->Deactivate();
+		}
+		else
+		{
+			Movement->Activate(true);
+		}
+
+		Character->GetMesh()->SetComponentTickEnabled(!bDormant);
+	}
+}
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "EOSPawnPool.generated.h"
+
+class APawn;
+
+/**
+ * Pool of dormant pawns pre-spawned at match setup. Players are handed a pawn from the pool when they join and the pawn
+ * goes back into the pool when they leave, so the server doesn't pay the spawn/destroy cost during a join burst.
+ */
+UCLASS()
+class EOS_OSS_TUTORIAL_API UEOSPawnPool : public UObject
+{
+	GENERATED_BODY()
+
+private:
+
+	// Every pawn owned by the pool, whether it is handed out or not. 
+	UPROPERTY()
+	TArray<TObjectPtr<APawn>> PooledPawns;
+
+	// Pawns currently sitting in the pool waiting for a player. 
+	UPROPERTY()
+	TArray<TObjectPtr<APawn>> DormantPawns;
+
+	UPROPERTY()
+	TSubclassOf<APawn> PawnClass;
+
+	// Average time it took to spawn a pawn while filling the pool. This is what every pooled hand out saves. 
+	double AverageSpawnSeconds = 0.0;
+
+	double TotalSavedSeconds = 0.0;
+
+	int32 NumPooledHandOuts = 0;
+
+	// Number of times the pool was empty and the game mode had to fall back to spawning. 
+	int32 NumPoolMisses = 0;
+
+public:
+
+	// Spawns PoolSize dormant pawns of InPawnClass. 
+	void Fill(UWorld* World, TSubclassOf<APawn> InPawnClass, int32 PoolSize);
+
+	// Wakes up a pawn from the pool at SpawnTransform. Returns nullptr if the pool can't serve this class or is empty. 
+	APawn* Acquire(TSubclassOf<APawn> RequestedClass, const FTransform& SpawnTransform);
+
+	// Puts a pawn back to sleep in the pool. Returns false if the pawn doesn't belong to the pool. 
+	bool Release(APawn* Pawn);
+
+	bool Owns(const APawn* Pawn) const;
+
+	// Logs how much spawn time the pool saved over the lifetime of the match. 
+	void LogSummary() const;
+
+private:
+
+	static void SetPawnDormant(APawn* Pawn, bool bDormant);
+};
@@ -3,6 +3,9 @@
 
 #include "EOSPlayerController.h"
 
+#include "EOS_OSS_TutorialGameMode.h"
+#include "EOSReservationBeaconClient.h"
+#include "OnlineBeaconHost.h"
 #include "OnlineSubsystem.h"
 #include "OnlineSubsystemUtils.h"
 #include "OnlineSubsystemTypes.h"
@@ -21,6 +24,18 @@ void AEOSPlayerController::BeginPlay()
     Login(); //Call login function 
 }
 
+void AEOSPlayerController::PawnLeavingGame()
+{
+    // The game mode only exists on the server, so this is a no-op everywhere else.
+    AEOS_OSS_TutorialGameMode* GameMode = GetWorld()->GetAuthGameMode<AEOS_OSS_TutorialGameMode>();
+    if (GameMode && GameMode->ReleasePawnToPool(GetPawn()))
+    {
+        return;
+    }
+
+    Super::PawnLeavingGame(); // Not a pooled pawn, destroy it as usual
+}
+
 void AEOSPlayerController::Login()
 {
 
@@ -120,3 +135,60 @@ void AEOSPlayerController::HandleLoginCompleted(int32 LocalUserNum, bool bWasSuc
     Identity->ClearOnLoginCompleteDelegate_Handle(LocalUserNum, LoginDelegateHandle);
     LoginDelegateHandle.Reset();
 }
+
+void AEOSPlayerController::JoinServer(const FString& ServerAddress, int32 BeaconPort)
+{
+	// The beacon listens on the same host as the game, on its own port
+	const FURL ServerURL(nullptr, *ServerAddress, TRAVEL_Absolute);
+	if (!ServerURL.Valid || ServerURL.Host.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("JoinServer: %s is not a valid server address."), *ServerAddress);
+		return;
+	}
+
+	if (BeaconPort <= 0)
+	{
+		BeaconPort = GetMutableDefault<AOnlineBeaconHost>()->GetListenPort();
+	}
+
+	// Only one request at a time, drop the one still waiting for an answer
+	if (IsValid(ReservationBeaconClient))
+	{
+		ReservationBeaconClient->OnReservationResponse.Clear();
+		ReservationBeaconClient->DestroyBeacon();
+	}
+
+	PendingServerAddress = ServerAddress;
+	ReservationBeaconClient = GetWorld()->SpawnActor<AEOSReservationBeaconClient>();
+	if (!ReservationBeaconClient)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("JoinServer: failed to spawn the reservation beacon client."));
+		return;
+	}
+
+	// Bind delegate to callback function
+	ReservationBeaconClient->OnReservationResponse.AddUObject(this, &ThisClass::HandleReservationResponse);
+
+	UE_LOG(LogTemp, Log, TEXT("Requesting a slot on %s..."), *ServerAddress);
+	if (!ReservationBeaconClient->RequestReservation(FString::Printf(TEXT("%s:%d"), *ServerURL.Host, BeaconPort), 1))
+	{
+		ReservationBeaconClient->OnReservationResponse.Clear();
+		ReservationBeaconClient->DestroyBeacon();
+		ReservationBeaconClient = nullptr;
+	}
+}
+
+void AEOSPlayerController::HandleReservationResponse(bool bAccepted, const FString& ReservationToken, int32 NumOccupiedSlots, int32 Capacity)
+{
+	// The beacon client destroys itself after an answer, a failed connection is cleaned up by the next JoinServer
+	if (!bAccepted)
+	{
+		const FString Message = Capacity > 0 ? FString::Printf(TEXT("Server is full (%d/%d)."), NumOccupiedSlots, Capacity) : TEXT("Couldn't reach the server.");
+		GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, Message);
+		UE_LOG(LogTemp, Warning, TEXT("Reservation on %s rejected: %s"), *PendingServerAddress, *Message);
+		return;
+	}
+
+	// The server only counts the slot as ours if the token comes along in the join URL
+	ClientTravel(FString::Printf(TEXT("%s?Reservation=%s"), *PendingServerAddress, *ReservationToken), TRAVEL_Absolute);
+}
@@ -6,6 +6,8 @@
 #include "GameFramework/PlayerController.h"
 #include "EOSPlayerController.generated.h"
 
+class AEOSReservationBeaconClient;
+
 /**
  * 
  */
@@ -19,18 +21,36 @@ private:
 	//Delegate to bind callback event for login. 
 	FDelegateHandle LoginDelegateHandle;
 
+	// Asks the server we want to join for a slot before travelling there. 
+	UPROPERTY(Transient)
+	TObjectPtr<AEOSReservationBeaconClient> ReservationBeaconClient;
+
+	// Address passed to JoinServer, travelled to once the reservation is accepted. 
+	FString PendingServerAddress;
+
 public:
 
 	AEOSPlayerController();
 
+	// Console command. Reserves a slot on the dedicated server at ServerAddress (host:port) through its reservation beacon and travels
+	// there with the reservation token. BeaconPort defaults to the ListenPort of the OnlineBeaconHost section in DefaultEngine.ini.
+	UFUNCTION(Exec)
+	void JoinServer(const FString& ServerAddress, int32 BeaconPort = 0);
+
 protected:
 
 	// Function called when play begins
 	virtual void BeginPlay();
+
+	// Called on the server when the player leaves. Hands the pawn back to the game mode's pawn pool instead of destroying it.
+	virtual void PawnLeavingGame() override;
  
 	//Function to sign into EOS Game Services
 	void Login();
  
 	//Callback function. This function is ran when signing into EOS Game Services completes. 
 	void HandleLoginCompleted(int32 LocalUserNum, bool bWasSuccessful, const FUniqueNetId& UserId, const FString& Error);
+
+	//Callback function. This function is ran when the server answers the reservation request from JoinServer. 
+	void HandleReservationResponse(bool bAccepted, const FString& ReservationToken, int32 NumOccupiedSlots, int32 Capacity);
 };
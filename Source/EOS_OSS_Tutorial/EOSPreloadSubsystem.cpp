@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EOSPreloadSubsystem.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+
+bool UEOSPreloadSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Only game clients travel. In the editor the packages are already loaded, so there is nothing to gain there either.
+	return !IsRunningDedicatedServer() && !GIsEditor && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UEOSPreloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PreloadStartTime = FPlatformTime::Seconds();
+
+	PostLoadMapDelegateHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::HandlePostLoadMap);
+
+	if (!TravelMapPackage.IsEmpty())
+	{
+		UE_LOG(LogTemp, Log, TEXT("Preloading travel map %s..."), *TravelMapPackage);
+		LoadPackageAsync(TravelMapPackage, FLoadPackageAsyncDelegate::CreateUObject(this, &ThisClass::HandleTravelMapPreloaded));
+	}
+
+	if (GameplayAssets.Num() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Preloading %d gameplay assets..."), GameplayAssets.Num());
+		GameplayAssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(GameplayAssets,
+			FStreamableDelegate::CreateUObject(this, &ThisClass::HandleGameplayAssetsPreloaded), FStreamableManager::AsyncLoadHighPriority);
+	}
+}
+
+void UEOSPreloadSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapDelegateHandle);
+	PostLoadMapDelegateHandle.Reset();
+
+	if (GameplayAssetsHandle.IsValid())
+	{
+		GameplayAssetsHandle->ReleaseHandle();
+		GameplayAssetsHandle.Reset();
+	}
+	PreloadedMapPackage = nullptr;
+
+	Super::Deinitialize();
+}
+
+void UEOSPreloadSubsystem::HandleTravelMapPreloaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+{
+	if (Result == EAsyncLoadingResult::Succeeded && LoadedPackage)
+	{
+		// The map may already have been loaded and consumed while the async request was in flight. Only hold it if it's still waiting for travel.
+		if (!bTravelMapPreloaded && !(GetWorld() && GetWorld()->GetOutermost() == LoadedPackage))
+		{
+			PreloadedMapPackage = LoadedPackage;
+		}
+		bTravelMapPreloaded = true;
+		UE_LOG(LogTemp, Log, TEXT("Travel map %s preloaded in %.2f s."), *PackageName.ToString(), FPlatformTime::Seconds() - PreloadStartTime);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to preload travel map %s!"), *PackageName.ToString());
+	}
+}
+
+void UEOSPreloadSubsystem::HandleGameplayAssetsPreloaded()
+{
+	UE_LOG(LogTemp, Log, TEXT("Gameplay assets preloaded in %.2f s."), FPlatformTime::Seconds() - PreloadStartTime);
+}
+
+void UEOSPreloadSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+	if (!LoadedWorld)
+	{
+		return;
+	}
+
+	// Travel reused the preloaded map, from now on the world keeps it alive. Holding on to it any longer would leak the world on the next travel.
+	if (LoadedWorld->GetOutermost()->GetFName() == FName(*TravelMapPackage))
+	{
+		bTravelMapPreloaded = true;
+		PreloadedMapPackage = nullptr;
+	}
+
+	// Once we're in game on a server the world references the pawn assets itself.
+	if (LoadedWorld->GetNetMode() == NM_Client && GameplayAssetsHandle.IsValid())
+	{
+		GameplayAssetsHandle->ReleaseHandle();
+		GameplayAssetsHandle.Reset();
+	}
+}
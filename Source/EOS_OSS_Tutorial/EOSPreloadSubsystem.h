@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/UObjectGlobals.h"
+#include "EOSPreloadSubsystem.generated.h"
+
+struct FStreamableHandle;
+
+/**
+ * Starts async loading the gameplay map and the pawn assets as soon as the client's game instance starts. Clients boot into
+ * the small entry map (GameDefaultMap), so the loading overlaps with the EOS login and session search instead of starting
+ * after travel. The loaded packages are kept alive until the gameplay map has been loaded, so travel finds them already in memory.
+ */
+UCLASS(config=Game)
+class EOS_OSS_TUTORIAL_API UEOSPreloadSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+private:
+
+	// Package name of the map the client travels to when joining a dedicated server. Both are set in DefaultGame.ini. 
+	UPROPERTY(config)
+	FString TravelMapPackage;
+
+	// Assets used once in game, e.g. the pawn class. Their mesh/animation dependencies are loaded with them. 
+	UPROPERTY(config)
+	TArray<FSoftObjectPath> GameplayAssets;
+
+	// Holds the preloaded map until travel picks it up. 
+	UPROPERTY(Transient)
+	TObjectPtr<UPackage> PreloadedMapPackage;
+
+	// Keeps the gameplay assets loaded until the gameplay map references them. 
+	TSharedPtr<FStreamableHandle> GameplayAssetsHandle;
+
+	FDelegateHandle PostLoadMapDelegateHandle;
+
+	double PreloadStartTime = 0.0;
+
+	bool bTravelMapPreloaded = false;
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	bool IsTravelMapPreloaded() const { return bTravelMapPreloaded; }
+
+private:
+
+	void HandleTravelMapPreloaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+
+	void HandleGameplayAssetsPreloaded();
+
+	// Drops our references once a map has loaded, the world holds on to whatever it uses from then on. 
+	void HandlePostLoadMap(UWorld* LoadedWorld);
+};
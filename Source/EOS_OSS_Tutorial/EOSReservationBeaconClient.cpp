@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EOSReservationBeaconClient.h"
+
+#include "EOSReservationBeaconHostObject.h"
+
+bool AEOSReservationBeaconClient::RequestReservation(const FString& ServerAddress, int32 NumSlots)
+{
+	NumSlotsToRequest = FMath::Max(NumSlots, 1);
+
+	FURL URL(nullptr, *ServerAddress, TRAVEL_Absolute);
+	if (!InitClient(URL))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to connect to reservation beacon at %s!"), *ServerAddress);
+		return false;
+	}
+
+	return true;
+}
+
+void AEOSReservationBeaconClient::OnConnected()
+{
+	Super::OnConnected();
+
+	ServerRequestReservation(NumSlotsToRequest);
+}
+
+void AEOSReservationBeaconClient::OnFailure()
+{
+	UE_LOG(LogTemp, Warning, TEXT("Reservation beacon connection failed."));
+	OnReservationResponse.Broadcast(false, FString(), 0, 0);
+	OnReservationResponse.Clear();
+
+	Super::OnFailure();
+}
+
+bool AEOSReservationBeaconClient::ServerRequestReservation_Validate(int32 NumSlots)
+{
+	return NumSlots > 0;
+}
+
+void AEOSReservationBeaconClient::ServerRequestReservation_Implementation(int32 NumSlots)
+{
+	if (bReservationRequested)
+	{
+		return;
+	}
+	bReservationRequested = true;
+
+	if (AEOSReservationBeaconHostObject* HostObject = Cast<AEOSReservationBeaconHostObject>(GetBeaconOwner()))
+	{
+		HostObject->HandleReservationRequest(this, NumSlots);
+	}
+}
+
+void AEOSReservationBeaconClient::ClientReservationResponse_Implementation(bool bAccepted, const FString& ReservationToken, int32 NumOccupiedSlots, int32 Capacity)
+{
+	UE_LOG(LogTemp, Log, TEXT("Reservation %s (%d/%d slots taken)."), bAccepted ? TEXT("accepted") : TEXT("rejected"), NumOccupiedSlots, Capacity);
+	OnReservationResponse.Broadcast(bAccepted, ReservationToken, NumOccupiedSlots, Capacity);
+	OnReservationResponse.Clear();
+
+	// One request per connection, the client doesn't need the beacon anymore
+	DestroyBeacon();
+}
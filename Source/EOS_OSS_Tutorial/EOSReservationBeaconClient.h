@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineBeaconClient.h"
+#include "EOSReservationBeaconClient.generated.h"
+
+// bAccepted, ReservationToken, NumOccupiedSlots, Capacity
+DECLARE_MULTICAST_DELEGATE_FourParams(FOnEOSReservationResponse, bool, const FString&, int32, int32);
+
+/**
+ * Client side of the reservation beacon. Asks a dedicated server for slots before travelling to it, so a full server turns the client
+ * away without a full connect and map load. On success travel to the server with ?Reservation=<ReservationToken> in the URL options,
+ * the reservation is held for the time configured on the server.
+ */
+UCLASS(transient, notplaceable)
+class EOS_OSS_TUTORIAL_API AEOSReservationBeaconClient : public AOnlineBeaconClient
+{
+	GENERATED_BODY()
+
+private:
+
+	// Number of slots to ask for once connected, one per party member. 
+	int32 NumSlotsToRequest = 1;
+
+	// Server: set once this connection has asked for a reservation, further requests are ignored. 
+	bool bReservationRequested = false;
+
+public:
+
+	// Broadcast once with the server's answer. A failed connection counts as a rejection with no occupancy info. 
+	FOnEOSReservationResponse OnReservationResponse;
+
+	// Connects to the beacon at ServerAddress (host:port) and asks for NumSlots slots. 
+	bool RequestReservation(const FString& ServerAddress, int32 NumSlots);
+
+	virtual void OnConnected() override;
+
+	virtual void OnFailure() override;
+
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ServerRequestReservation(int32 NumSlots);
+
+	UFUNCTION(Client, Reliable)
+	void ClientReservationResponse(bool bAccepted, const FString& ReservationToken, int32 NumOccupiedSlots, int32 Capacity);
+};
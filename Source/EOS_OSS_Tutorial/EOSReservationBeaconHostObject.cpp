@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EOSReservationBeaconHostObject.h"
+
+#include "EOSGameSession.h"
+#include "EOSReservationBeaconClient.h"
+
+AEOSReservationBeaconHostObject::AEOSReservationBeaconHostObject(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	ClientBeaconActorClass = AEOSReservationBeaconClient::StaticClass();
+	BeaconTypeName = ClientBeaconActorClass->GetName();
+}
+
+void AEOSReservationBeaconHostObject::HandleReservationRequest(AEOSReservationBeaconClient* Client, int32 NumSlots)
+{
+	AEOSGameSession* Session = GameSession.Get();
+
+	FString ReservationToken;
+	const bool bAccepted = Session && Session->TryReserveSlots(NumSlots, ReservationToken);
+
+	const int32 NumOccupiedSlots = Session ? Session->GetNumOccupiedSlots() : 0;
+	const int32 Capacity = Session ? Session->GetMaxNumberOfPlayersInSession() : 0;
+
+	Client->ClientReservationResponse(bAccepted, ReservationToken, NumOccupiedSlots, Capacity);
+
+	// One request per connection. Closing it means a client has to connect again for every request instead of holding the connection open.
+	DisconnectClient(Client);
+}
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineBeaconHostObject.h"
+#include "EOSReservationBeaconHostObject.generated.h"
+
+class AEOSGameSession;
+class AEOSReservationBeaconClient;
+
+/**
+ * Server side of the reservation beacon. Answers slot requests from AEOSReservationBeaconClient with the game session's
+ * reservation bookkeeping.
+ */
+UCLASS(transient, notplaceable)
+class EOS_OSS_TUTORIAL_API AEOSReservationBeaconHostObject : public AOnlineBeaconHostObject
+{
+	GENERATED_BODY()
+
+private:
+
+	UPROPERTY()
+	TWeakObjectPtr<AEOSGameSession> GameSession;
+
+public:
+
+	AEOSReservationBeaconHostObject(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	void SetGameSession(AEOSGameSession* InGameSession) { GameSession = InGameSession; }
+
+	void HandleReservationRequest(AEOSReservationBeaconClient* Client, int32 NumSlots);
+};
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EOSSessionAttributes.h"
+
+namespace EOSSessionAttributes
+{
+	const TEOSSessionAttribute<int32> BuildVersion{ TEXT("BUILDVERSION"), EOnlineDataAdvertisementType::ViaOnlineService };
+
+	// Not SETTING_GAMEMODE, the engine advertises that one as a string. 
+	const TEOSSessionAttribute<EEOSSessionGameMode> GameMode{ TEXT("GAMEMODEID"), EOnlineDataAdvertisementType::ViaOnlineService };
+
+	const TEOSSessionAttribute<FString> MapName{ SETTING_MAPNAME, EOnlineDataAdvertisementType::ViaOnlineService };
+
+	const TEOSSessionAttribute<bool> AcceptingPlayers{ TEXT("ACCEPTINGPLAYERS"), EOnlineDataAdvertisementType::ViaOnlineService };
+
+	const TEOSSessionAttribute<int32> BeaconPort{ TEXT("BEACONPORT"), EOnlineDataAdvertisementType::ViaOnlineService };
+
+	void ApplyServerAttributes(FOnlineSessionSettings& Settings, EEOSSessionGameMode InGameMode, const FString& InMapName, bool bInAcceptingPlayers)
+	{
+		BuildVersion.Set(Settings, CurrentBuildVersion);
+		GameMode.Set(Settings, InGameMode);
+		MapName.Set(Settings, InMapName);
+		AcceptingPlayers.Set(Settings, bInAcceptingPlayers);
+	}
+
+	void BuildSearchQuery(FOnlineSearchSettings& QuerySettings, EEOSSessionGameMode InGameMode)
+	{
+		BuildVersion.AddToQuery(QuerySettings, CurrentBuildVersion);
+		GameMode.AddToQuery(QuerySettings, InGameMode);
+		AcceptingPlayers.AddToQuery(QuerySettings, true);
+	}
+}
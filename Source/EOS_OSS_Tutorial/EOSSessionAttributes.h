@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSessionSettings.h"
+#include <type_traits>
+
+/**
+ * Game modes a dedicated server can advertise. Travels through the session as an int32.
+ */
+enum class EEOSSessionGameMode : uint8
+{
+	ThirdPerson = 0
+};
+
+/**
+ * Maps the C++ type of an attribute onto the type that is actually stored in the session settings.
+ * Most types are stored as-is, enums are stored as int32 as that is what the OSS can advertise.
+ */
+template <typename ValueType, typename = void>
+struct TEOSSessionAttributeStorage
+{
+	using Type = ValueType;
+
+	static Type ToStorage(const ValueType& Value) { return Value; }
+	static ValueType FromStorage(const Type& Value) { return Value; }
+};
+
+template <typename EnumType>
+struct TEOSSessionAttributeStorage<EnumType, std::enable_if_t<std::is_enum_v<EnumType>>>
+{
+	using Type = int32;
+
+	static Type ToStorage(EnumType Value) { return static_cast<int32>(Value); }
+	static EnumType FromStorage(Type Value) { return static_cast<EnumType>(Value); }
+};
+
+/**
+ * A single typed session attribute. The key and advertisement type are declared once in EOSSessionAttributes,
+ * so the server and the clients can't drift apart on spelling or on the type of the value.
+ */
+template <typename ValueType>
+struct TEOSSessionAttribute
+{
+	using FStorage = TEOSSessionAttributeStorage<ValueType>;
+
+	FName Key;
+	EOnlineDataAdvertisementType::Type AdvertisementType;
+
+	// Server: writes the attribute into the settings block, overwriting the previous value if there is one.
+	void Set(FOnlineSessionSettings& Settings, const ValueType& Value) const
+	{
+		Settings.Set(Key, FStorage::ToStorage(Value), AdvertisementType);
+	}
+
+	// Client: reads the attribute back from a search result. Returns false if the session doesn't advertise it.
+	bool Get(const FOnlineSessionSettings& Settings, ValueType& OutValue) const
+	{
+		typename FStorage::Type StoredValue{};
+		if (!Settings.Get(Key, StoredValue))
+		{
+			return false;
+		}
+
+		OutValue = FStorage::FromStorage(StoredValue);
+		return true;
+	}
+
+	// Client: adds a filter on this attribute to a session search.
+	void AddToQuery(FOnlineSearchSettings& QuerySettings, const ValueType& Value, EOnlineComparisonOp::Type ComparisonOp = EOnlineComparisonOp::Equals) const
+	{
+		QuerySettings.Set(Key, FStorage::ToStorage(Value), ComparisonOp);
+	}
+};
+
+/**
+ * The session attribute schema. Every custom attribute the dedicated server advertises is declared here.
+ */
+namespace EOSSessionAttributes
+{
+	// Bump this when clients and servers stop being compatible. Clients only search for sessions of their own version.
+	constexpr int32 CurrentBuildVersion = 1;
+
+	extern EOS_OSS_TUTORIAL_API const TEOSSessionAttribute<int32> BuildVersion;
+
+	extern EOS_OSS_TUTORIAL_API const TEOSSessionAttribute<EEOSSessionGameMode> GameMode;
+
+	// Uses the engine's SETTING_MAPNAME key, which is string valued like ours. 
+	extern EOS_OSS_TUTORIAL_API const TEOSSessionAttribute<FString> MapName;
+
+	// False once the server is full or its match has started. Kept up to date with UpdateSession. 
+	extern EOS_OSS_TUTORIAL_API const TEOSSessionAttribute<bool> AcceptingPlayers;
+
+	// Port of the server's reservation beacon, clients ask it for slots before travelling. 
+	extern EOS_OSS_TUTORIAL_API const TEOSSessionAttribute<int32> BeaconPort;
+
+	// Server: fills every schema attribute in a (reusable) settings block.
+	EOS_OSS_TUTORIAL_API void ApplyServerAttributes(FOnlineSessionSettings& Settings, EEOSSessionGameMode InGameMode, const FString& InMapName, bool bInAcceptingPlayers);
+
+	// Client: builds the search query that matches what ApplyServerAttributes advertises.
+	EOS_OSS_TUTORIAL_API void BuildSearchQuery(FOnlineSearchSettings& QuerySettings, EEOSSessionGameMode InGameMode);
+}
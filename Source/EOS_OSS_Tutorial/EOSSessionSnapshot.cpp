@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EOSSessionSnapshot.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+void FEOSSessionSnapshot::Serialize(FArchive& Ar)
+{
+	uint8 LifecycleValue = static_cast<uint8>(Lifecycle);
+	uint8 GameModeValue = static_cast<uint8>(GameMode);
+
+	Ar << LifecycleValue;
+	Ar << SessionId;
+	Ar << GameModeValue;
+	Ar << MapName;
+	Ar << MaxPlayers;
+	Ar << RegisteredPlayerIds;
+	Ar << LeakedSessionIds;
+	Ar << WrittenAt;
+
+	if (Ar.IsLoading())
+	{
+		Lifecycle = static_cast<EEOSSessionLifecycle>(LifecycleValue);
+		GameMode = static_cast<EEOSSessionGameMode>(GameModeValue);
+	}
+}
+
+void FEOSSessionSnapshot::AddLeakedSessionId(const FString& InSessionId)
+{
+	if (InSessionId.IsEmpty() || LeakedSessionIds.Contains(InSessionId))
+	{
+		return;
+	}
+
+	// Drop the oldest, so the snapshot keeps fitting in its block
+	if (LeakedSessionIds.Num() >= MaxLeakedSessionIds)
+	{
+		LeakedSessionIds.RemoveAt(0);
+	}
+	LeakedSessionIds.Add(InSessionId);
+}
+
+const TCHAR* FEOSSessionSnapshot::LexToString(EEOSSessionLifecycle Lifecycle)
+{
+	switch (Lifecycle)
+	{
+	case EEOSSessionLifecycle::Creating:
+		return TEXT("Creating");
+	case EEOSSessionLifecycle::Created:
+		return TEXT("Created");
+	case EEOSSessionLifecycle::Started:
+		return TEXT("Started");
+	case EEOSSessionLifecycle::Ended:
+		return TEXT("Ended");
+	case EEOSSessionLifecycle::Destroyed:
+		return TEXT("Destroyed");
+	default:
+		return TEXT("None");
+	}
+}
+
+FEOSSessionSnapshotFile::~FEOSSessionSnapshotFile()
+{
+	Close();
+}
+
+FString FEOSSessionSnapshotFile::GetSnapshotPath(int32 Port)
+{
+	// One snapshot per port, so several servers on the same machine don't pick up each other's sessions
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("EOSSession"), FString::Printf(TEXT("Snapshot_%d.bin"), Port));
+}
+
+bool FEOSSessionSnapshotFile::Load(const FString& Path, FEOSSessionSnapshot& OutSnapshot)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Path, FILEREAD_Silent) || Data.Num() < HeaderSize)
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	uint32 PayloadSize = 0;
+	uint32 PayloadCrc = 0;
+	Reader << FileMagic << FileVersion << PayloadSize << PayloadCrc;
+
+	if (FileMagic != Magic || FileVersion != Version || PayloadSize > static_cast<uint32>(Data.Num() - HeaderSize))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Ignoring session snapshot %s, it is from another version or truncated."), *Path);
+		return false;
+	}
+
+	if (FCrc::MemCrc32(Data.GetData() + HeaderSize, PayloadSize) != PayloadCrc)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Ignoring session snapshot %s, the checksum doesn't match."), *Path);
+		return false;
+	}
+
+	OutSnapshot.Serialize(Reader);
+	return !Reader.IsError();
+}
+
+bool FEOSSessionSnapshotFile::Open(const FString& Path)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Path));
+
+	FileHandle.Reset(PlatformFile.OpenWrite(*Path, false, true));
+	if (!FileHandle)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to open session snapshot %s!"), *Path);
+		return false;
+	}
+
+	return true;
+}
+
+void FEOSSessionSnapshotFile::Close()
+{
+	FileHandle.Reset();
+}
+
+bool FEOSSessionSnapshotFile::Write(FEOSSessionSnapshot& Snapshot)
+{
+	if (!FileHandle)
+	{
+		return false;
+	}
+
+	Snapshot.WrittenAt = FDateTime::UtcNow().ToUnixTimestamp();
+
+	// Serialise the payload behind the header, then fill the header in once the payload size and crc are known
+	Block.Reset();
+	Block.AddZeroed(HeaderSize);
+	FMemoryWriter Writer(Block, false, true);
+	Writer.Seek(HeaderSize);
+	Snapshot.Serialize(Writer);
+
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = Version;
+	uint32 PayloadSize = Block.Num() - HeaderSize;
+	uint32 PayloadCrc = FCrc::MemCrc32(Block.GetData() + HeaderSize, PayloadSize);
+	Writer.Seek(0);
+	Writer << FileMagic << FileVersion << PayloadSize << PayloadCrc;
+
+	if (Block.Num() < BlockSize)
+	{
+		Block.AddZeroed(BlockSize - Block.Num());
+	}
+
+	if (!FileHandle->Seek(0) || !FileHandle->Write(Block.GetData(), Block.Num()) || !FileHandle->Flush())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to write session snapshot!"));
+		return false;
+	}
+
+	return true;
+}
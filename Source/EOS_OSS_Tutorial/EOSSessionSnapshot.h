@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EOSSessionAttributes.h"
+
+class IFileHandle;
+
+/**
+ * Where the dedicated server's EOS session is in its lifecycle.
+ */
+enum class EEOSSessionLifecycle : uint8
+{
+	None,
+	Creating,
+	Created,
+	Started,
+	Ended,
+	Destroyed
+};
+
+/**
+ * Small snapshot of the dedicated server's session state. Written on every lifecycle transition, so a server restarted after a crash
+ * knows which session it left behind and can take it over again instead of leaking it.
+ */
+struct FEOSSessionSnapshot
+{
+	EEOSSessionLifecycle Lifecycle = EEOSSessionLifecycle::None;
+
+	FString SessionId;
+
+	// The settings the session was created with, restored when a later process re-adopts it. 
+	EEOSSessionGameMode GameMode = EEOSSessionGameMode::ThirdPerson;
+	FString MapName;
+	int32 MaxPlayers = 0;
+
+	TArray<FString> RegisteredPlayerIds;
+
+	// Sessions of earlier processes that could be neither re-adopted nor destroyed, so they are still on the backend. Kept across
+	// restarts so they stay visible in the logs, oldest first and at most MaxLeakedSessionIds of them. 
+	TArray<FString> LeakedSessionIds;
+
+	static constexpr int32 MaxLeakedSessionIds = 16;
+
+	// When the snapshot was last written, as a unix timestamp. 
+	int64 WrittenAt = 0;
+
+	// True if the session this snapshot describes was never destroyed. 
+	bool NeedsRecovery() const { return Lifecycle != EEOSSessionLifecycle::None && Lifecycle != EEOSSessionLifecycle::Destroyed; }
+
+	void AddLeakedSessionId(const FString& InSessionId);
+
+	void Serialize(FArchive& Ar);
+
+	static const TCHAR* LexToString(EEOSSessionLifecycle Lifecycle);
+};
+
+/**
+ * The file backing the snapshot. It is kept open and overwritten in place as one fixed-size, checksummed block, so a write is a single
+ * seek + write + flush and a write torn by a crash is detected on load instead of being read back as garbage.
+ */
+class FEOSSessionSnapshotFile
+{
+public:
+
+	// Size of the block the snapshot is written into. Large enough for a full session's worth of player ids. 
+	static constexpr int32 BlockSize = 4096;
+
+	~FEOSSessionSnapshotFile();
+
+	static FString GetSnapshotPath(int32 Port);
+
+	// Reads the snapshot a previous process left behind. Returns false if there is none or it is corrupt. 
+	static bool Load(const FString& Path, FEOSSessionSnapshot& OutSnapshot);
+
+	bool Open(const FString& Path);
+
+	void Close();
+
+	bool Write(FEOSSessionSnapshot& Snapshot);
+
+private:
+
+	static constexpr uint32 Magic = 0x454F5353; // "EOSS"
+
+	// Bump when the layout of FEOSSessionSnapshot changes. Older snapshots are then ignored. 
+	static constexpr uint32 Version = 2;
+
+	// Magic, version, payload size and payload crc. 
+	static constexpr int32 HeaderSize = 4 * sizeof(uint32);
+
+	TUniquePtr<IFileHandle> FileHandle;
+
+	// Reused for every write so writing doesn't allocate. 
+	TArray<uint8> Block;
+};
@@ -10,6 +10,8 @@
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
+#include "EOSCharacterSignificanceSubsystem.h"
+#include "EOSMovementValidationSubsystem.h"
 
 DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 
@@ -58,6 +60,44 @@ void AEOS_OSS_TutorialCharacter::BeginPlay()
 {
 	// Call the base class  
 	Super::BeginPlay();
+
+	// The server validates the moves of every character in one batched pass per tick
+	if (UEOSMovementValidationSubsystem* MovementValidation = GetWorld()->GetSubsystem<UEOSMovementValidationSubsystem>())
+	{
+		MovementValidation->RegisterCharacter(this);
+	}
+
+	// The server throttles movement and animation updates of characters that don't matter right now
+	if (UEOSCharacterSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UEOSCharacterSignificanceSubsystem>())
+	{
+		Significance->RegisterCharacter(this);
+	}
+}
+
+void AEOS_OSS_TutorialCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEOSMovementValidationSubsystem* MovementValidation = GetWorld()->GetSubsystem<UEOSMovementValidationSubsystem>())
+	{
+		MovementValidation->UnregisterCharacter(this);
+	}
+
+	if (UEOSCharacterSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UEOSCharacterSignificanceSubsystem>())
+	{
+		Significance->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AEOS_OSS_TutorialCharacter::LaunchCharacter(FVector LaunchVelocity, bool bXYOverride, bool bZOverride)
+{
+	Super::LaunchCharacter(LaunchVelocity, bXYOverride, bZOverride);
+
+	// A launch legitimately exceeds the walking limits until the character lands again
+	if (UEOSMovementValidationSubsystem* MovementValidation = GetWorld()->GetSubsystem<UEOSMovementValidationSubsystem>())
+	{
+		MovementValidation->ExemptUntilGrounded(this);
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////
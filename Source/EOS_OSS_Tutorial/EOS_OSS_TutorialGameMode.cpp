@@ -3,19 +3,91 @@
 #include "EOS_OSS_TutorialGameMode.h"
 
 #include "EOSGameSession.h"
+#include "EOSPawnPool.h"
 #include "EOSPlayerController.h"
 #include "EOS_OSS_TutorialCharacter.h"
-#include "UObject/ConstructorHelpers.h"
+#include "Kismet/GameplayStatics.h"
 
 AEOS_OSS_TutorialGameMode::AEOS_OSS_TutorialGameMode()
 {
-	// set default pawn class to our Blueprinted character
-	static ConstructorHelpers::FClassFinder<APawn> PlayerPawnBPClass(TEXT("/Game/ThirdPerson/Blueprints/BP_ThirdPersonCharacter"));
-	if (PlayerPawnBPClass.Class != NULL)
-	{
-		DefaultPawnClass = PlayerPawnBPClass.Class;
-	}
+	// set default pawn class to our Blueprinted character, see InitGame
+	PlayerPawnClass = TSoftClassPtr<APawn>(FSoftObjectPath(TEXT("/Game/ThirdPerson/Blueprints/BP_ThirdPersonCharacter.BP_ThirdPersonCharacter_C")));
 
 	PlayerControllerClass = AEOSPlayerController::StaticClass();
 	GameSessionClass = AEOSGameSession::StaticClass(); // Tutorial 3: Setting the GameSession class to our custom one.// Tutorial 2: Setting the PlayerController to our custom one.
 }
+
+void AEOS_OSS_TutorialGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	// Only blocks if the pawn wasn't preloaded (always the case on the dedicated server, which doesn't preload)
+	if (UClass* PawnClass = PlayerPawnClass.LoadSynchronous())
+	{
+		DefaultPawnClass = PawnClass;
+	}
+
+	Super::InitGame(MapName, Options, ErrorMessage);
+}
+
+void AEOS_OSS_TutorialGameMode::StartPlay()
+{
+	// Pre-spawn one dormant pawn per session slot before anyone can join, so joining players don't cause spawn hitches
+	if (IsRunningDedicatedServer())
+	{
+		if (AEOSGameSession* EOSGameSession = Cast<AEOSGameSession>(GameSession))
+		{
+			PawnPool = NewObject<UEOSPawnPool>(this);
+			PawnPool->Fill(GetWorld(), DefaultPawnClass, EOSGameSession->GetMaxNumberOfPlayersInSession());
+		}
+	}
+
+	Super::StartPlay();
+}
+
+void AEOS_OSS_TutorialGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (PawnPool)
+	{
+		PawnPool->LogSummary();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+FString AEOS_OSS_TutorialGameMode::InitNewPlayer(APlayerController* NewPlayerController, const FUniqueNetIdRepl& UniqueId, const FString& Options, const FString& Portal)
+{
+	if (AEOSGameSession* EOSGameSession = Cast<AEOSGameSession>(GameSession))
+	{
+		EOSGameSession->CompleteReservationSlot(UGameplayStatics::ParseOption(Options, TEXT("Reservation")));
+	}
+
+	return Super::InitNewPlayer(NewPlayerController, UniqueId, Options, Portal);
+}
+
+APawn* AEOS_OSS_TutorialGameMode::SpawnDefaultPawnAtTransform_Implementation(AController* NewPlayer, const FTransform& SpawnTransform)
+{
+	if (PawnPool)
+	{
+		if (APawn* PooledPawn = PawnPool->Acquire(GetDefaultPawnClassForController(NewPlayer), SpawnTransform))
+		{
+			return PooledPawn;
+		}
+	}
+
+	// Pool is empty or doesn't serve this pawn class, spawn one the usual way
+	return Super::SpawnDefaultPawnAtTransform_Implementation(NewPlayer, SpawnTransform);
+}
+
+bool AEOS_OSS_TutorialGameMode::ReleasePawnToPool(APawn* Pawn)
+{
+	if (!PawnPool || !PawnPool->Owns(Pawn))
+	{
+		return false;
+	}
+
+	if (AController* Controller = Pawn->GetController())
+	{
+		Controller->UnPossess();
+	}
+
+	return PawnPool->Release(Pawn);
+}
@@ -6,14 +6,35 @@
 #include "GameFramework/GameModeBase.h"
 #include "EOS_OSS_TutorialGameMode.generated.h"
 
+class UEOSPawnPool;
+
 UCLASS(minimalapi)
 class AEOS_OSS_TutorialGameMode : public AGameModeBase
 {
 	GENERATED_BODY()
 
+	/** Resolved in InitGame. Kept soft so constructing the CDO doesn't load the pawn on every client at startup */
+	UPROPERTY()
+	TSoftClassPtr<APawn> PlayerPawnClass;
+
+	/** Dormant pawns pre-spawned on the dedicated server, handed out on join and taken back on leave */
+	UPROPERTY(Transient)
+	TObjectPtr<UEOSPawnPool> PawnPool;
+
 public:
 	AEOS_OSS_TutorialGameMode();
-};
 
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
 
+	virtual void StartPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Releases the player's reserved slot on the game session, the player counts towards the game mode's players from here on */
+	virtual FString InitNewPlayer(APlayerController* NewPlayerController, const FUniqueNetIdRepl& UniqueId, const FString& Options, const FString& Portal = TEXT("")) override;
+
+	virtual APawn* SpawnDefaultPawnAtTransform_Implementation(AController* NewPlayer, const FTransform& SpawnTransform) override;
+
+	/** Returns a pawn to the pool instead of destroying it. Returns false if the pawn isn't pooled. */
+	bool ReleasePawnToPool(APawn* Pawn);
+};